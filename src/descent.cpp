@@ -0,0 +1,691 @@
+// The parser of --parser=descent: the grammar of parser.y written out as
+// recursive descent, with the operators of Expression parsed by precedence
+// climbing (Pratt parsing) instead of a chain of reductions. It builds the
+// same AST as parser.y, takes its tokens from the same nextParserToken() and
+// reports a syntax error at the same token, as long as the input nests no
+// deeper than kMaxNestingDepth.
+#include "AST/BinaryOperator.hpp"
+#include "AST/CompoundStatement.hpp"
+#include "AST/ConstantValue.hpp"
+#include "AST/FunctionInvocation.hpp"
+#include "AST/UnaryOperator.hpp"
+#include "AST/VariableReference.hpp"
+#include "AST/assignment.hpp"
+#include "AST/ast.hpp"
+#include "AST/decl.hpp"
+#include "AST/expression.hpp"
+#include "AST/for.hpp"
+#include "AST/function.hpp"
+#include "AST/if.hpp"
+#include "AST/print.hpp"
+#include "AST/program.hpp"
+#include "AST/read.hpp"
+#include "AST/return.hpp"
+#include "AST/while.hpp"
+
+#include "AST/constant.hpp"
+#include "AST/operator.hpp"
+
+#include "driver/CompilationContext.hpp"
+#include "sema/SemanticAnalyzer.hpp"
+#include "util/Arena.hpp"
+
+#include "parser.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+using token = yy::parser::token;
+
+// The levels of the %left and %right declarations in parser.y, lowest
+// first. A prefix operator takes the operators above its own level into its
+// operand, as bison resolves `not a = b` and `-a * b`.
+enum Precedence : int {
+    kOrPrecedence = 1,
+    kAndPrecedence,
+    kNotPrecedence,
+    kRelationalPrecedence,
+    kAdditivePrecedence,
+    kMultiplicativePrecedence,
+    kUnaryMinusPrecedence,
+};
+
+// How deep blocks and expressions may nest, together. Each level is a
+// recursion of the parser, of a few hundred bytes of native stack, so a
+// deeper input is reported as an error rather than let overflow the stack.
+constexpr int kMaxNestingDepth = 10000;
+
+struct BinaryOperator {
+    int precedence; // 0 if the token is not a binary operator
+    Operator op;
+};
+
+BinaryOperator lookUpBinaryOperator(const int p_token) {
+    switch (p_token) {
+    case token::OR:
+        return {kOrPrecedence, Operator::kOrOp};
+    case token::AND:
+        return {kAndPrecedence, Operator::kAndOp};
+    case token::LESS:
+        return {kRelationalPrecedence, Operator::kLessOp};
+    case token::LESS_OR_EQUAL:
+        return {kRelationalPrecedence, Operator::kLessOrEqualOp};
+    case token::EQUAL:
+        return {kRelationalPrecedence, Operator::kEqualOp};
+    case token::GREATER:
+        return {kRelationalPrecedence, Operator::kGreaterOp};
+    case token::GREATER_OR_EQUAL:
+        return {kRelationalPrecedence, Operator::kGreaterOrEqualOp};
+    case token::NOT_EQUAL:
+        return {kRelationalPrecedence, Operator::kNotEqualOp};
+    case token::PLUS:
+        return {kAdditivePrecedence, Operator::kPlusOp};
+    case token::MINUS:
+        return {kAdditivePrecedence, Operator::kMinusOp};
+    case token::MULTIPLY:
+        return {kMultiplicativePrecedence, Operator::kMultiplyOp};
+    case token::DIVIDE:
+        return {kMultiplicativePrecedence, Operator::kDivideOp};
+    case token::MOD:
+        return {kMultiplicativePrecedence, Operator::kModOp};
+    default:
+        return {0, Operator::kPlusOp};
+    }
+}
+
+// unwinds to parseProgramByDescent() once the error is reported
+struct SyntaxError {};
+
+class DescentParser {
+  private:
+    CompilationContext &m_context;
+
+    // the lookahead
+    int m_token = 0;
+    TokenValue m_value = {};
+    YYLTYPE m_location;
+    LazyFunctionBody *m_body = nullptr;
+
+    // the blocks and expressions being parsed, see kMaxNestingDepth
+    int m_depth = 0;
+
+    // one of them, for the time its parse function runs
+    class NestingLevel {
+      private:
+        DescentParser &m_parser;
+
+      public:
+        ~NestingLevel() { --m_parser.m_depth; }
+        explicit NestingLevel(DescentParser &p_parser) : m_parser(p_parser) {
+            if (++m_parser.m_depth > kMaxNestingDepth) {
+                m_parser.failTooDeep();
+            }
+        }
+
+        NestingLevel(const NestingLevel &) = delete;
+        NestingLevel &operator=(const NestingLevel &) = delete;
+    };
+
+  public:
+    ~DescentParser() = default;
+    explicit DescentParser(CompilationContext &p_context)
+        : m_context(p_context) {}
+
+    DescentParser(const DescentParser &) = delete;
+    DescentParser &operator=(const DescentParser &) = delete;
+
+    // Start: Program | BODY_ONLY CompoundStatement
+    void parseStart() {
+        advance();
+        if (m_token == token::BODY_ONLY) {
+            advance();
+            m_context.root = parseCompoundStatement();
+        } else {
+            m_context.root = parseProgram();
+        }
+        expect(token::YYEOF);
+    }
+
+  private:
+    void advance() {
+        m_token = nextParserToken(m_context, m_value, m_location, m_body);
+    }
+
+    [[noreturn]] void fail() {
+        reportSyntaxError(m_context);
+        throw SyntaxError();
+    }
+
+    [[noreturn]] void failTooDeep() {
+        char reason[64];
+        snprintf(reason, sizeof(reason), "Nested more than %d levels deep",
+                 kMaxNestingDepth);
+        reportSyntaxError(m_context, reason);
+        throw SyntaxError();
+    }
+
+    void expect(const int p_token) {
+        if (m_token != p_token) {
+            fail();
+        }
+        if (p_token != token::YYEOF) {
+            advance();
+        }
+    }
+
+    Atom expectId() {
+        if (m_token != token::ID) {
+            fail();
+        }
+        const Atom id = m_value.identifier;
+        advance();
+        return id;
+    }
+
+    uint32_t expectIntLiteral() {
+        if (m_token != token::INT_LITERAL) {
+            fail();
+        }
+        const uint32_t integer = m_value.integer;
+        advance();
+        return integer;
+    }
+
+    ProgramNode *parseProgram() {
+        const YYLTYPE location = m_location;
+        const Atom name = expectId();
+        expect(token::SEMICOLON);
+        const ArenaVector<DeclNode *> decls = parseDeclarationList();
+        if (m_context.analyzer != nullptr) {
+            m_context.analyzer->beginProgram(
+                name, Location(location.first_line, location.first_column));
+            for (DeclNode *const decl : decls) {
+                m_context.analyzer->walk(*decl);
+            }
+            m_context.functions_mark = Arena::getInstance().getMark();
+        }
+
+        ArenaVector<FunctionNode *> functions;
+        while (m_token == token::ID) {
+            FunctionNode *const function = parseFunction();
+            if (m_context.analyzer != nullptr) {
+                m_context.analyzer->walk(*function);
+                Arena::getInstance().rewind(m_context.functions_mark);
+            } else {
+                functions.push_back(function);
+            }
+        }
+
+        CompoundStatementNode *const body = parseCompoundStatement();
+        expect(token::END);
+        return newInArena<ProgramNode>(
+            location.first_line, location.first_column, name,
+            TypeContext::kVoidType, decls, functions, body);
+    }
+
+    ArenaVector<DeclNode *> parseDeclarationList() {
+        ArenaVector<DeclNode *> decls;
+        while (m_token == token::VAR) {
+            decls.push_back(parseDeclaration());
+        }
+        return decls;
+    }
+
+    FunctionNode *parseFunction() {
+        const YYLTYPE location = m_location;
+        const Atom name = expectId();
+        expect(token::L_PARENTHESIS);
+        ArenaVector<DeclNode *> args;
+        if (m_token == token::ID) {
+            args.push_back(parseFormalArg());
+            while (m_token == token::SEMICOLON) {
+                advance();
+                args.push_back(parseFormalArg());
+            }
+        }
+        expect(token::R_PARENTHESIS);
+
+        TypeId return_type = TypeContext::kVoidType;
+        if (m_token == token::COLON) {
+            advance();
+            return_type = parseScalarType();
+        }
+
+        CompoundStatementNode *body = nullptr;
+        const LazyFunctionBody *lazy_body = nullptr;
+        switch (m_token) {
+        case token::SEMICOLON:
+            advance();
+            return newInArena<FunctionNode>(location.first_line,
+                                            location.first_column, name, args,
+                                            return_type, nullptr);
+        case token::BEGIN_:
+            body = parseCompoundStatement();
+            break;
+        case token::LAZY_BODY:
+            lazy_body = m_body;
+            advance();
+            break;
+        default:
+            fail();
+        }
+        expect(token::END);
+        return newInArena<FunctionNode>(location.first_line,
+                                        location.first_column, name, args,
+                                        return_type, body, lazy_body);
+    }
+
+    // FormalArg: IdList COLON Type
+    DeclNode *parseFormalArg() {
+        const YYLTYPE location = m_location;
+        const ArenaVector<IdInfo> ids = parseIdList();
+        expect(token::COLON);
+        const TypeId type = parseType();
+        return newInArena<DeclNode>(location.first_line, location.first_column,
+                                    ids, type);
+    }
+
+    ArenaVector<IdInfo> parseIdList() {
+        ArenaVector<IdInfo> ids;
+        for (;;) {
+            const YYLTYPE location = m_location;
+            const Atom id = expectId();
+            ids.emplace_back(location.first_line, location.first_column, id);
+            if (m_token != token::COMMA) {
+                return ids;
+            }
+            advance();
+        }
+    }
+
+    DeclNode *parseDeclaration() {
+        const YYLTYPE location = m_location;
+        expect(token::VAR);
+        const ArenaVector<IdInfo> ids = parseIdList();
+        expect(token::COLON);
+
+        DeclNode *decl;
+        switch (m_token) {
+        case token::MINUS:
+        case token::INT_LITERAL:
+        case token::REAL_LITERAL:
+        case token::STRING_LITERAL:
+        case token::TRUE:
+        case token::FALSE:
+            decl = newInArena<DeclNode>(location.first_line,
+                                        location.first_column, ids,
+                                        parseLiteralConstant());
+            break;
+        default:
+            decl = newInArena<DeclNode>(location.first_line,
+                                        location.first_column, ids,
+                                        parseType());
+            break;
+        }
+        expect(token::SEMICOLON);
+        return decl;
+    }
+
+    // Type: ScalarType | ARRAY INT_LITERAL OF ... ScalarType
+    TypeId parseType() {
+        if (m_token != token::ARRAY) {
+            return parseScalarType();
+        }
+        ArenaVector<uint64_t> dimensions;
+        while (m_token == token::ARRAY) {
+            advance();
+            dimensions.emplace_back(static_cast<uint64_t>(expectIntLiteral()));
+            expect(token::OF);
+        }
+        const TypeId element_type = parseScalarType();
+        return TypeContext::getInstance().intern(
+            getPType(element_type).getPrimitiveType(), dimensions.begin(),
+            dimensions.size());
+    }
+
+    TypeId parseScalarType() {
+        PType::PrimitiveTypeEnum primitive;
+        switch (m_token) {
+        case token::INTEGER:
+            primitive = PType::PrimitiveTypeEnum::kIntegerType;
+            break;
+        case token::REAL:
+            primitive = PType::PrimitiveTypeEnum::kRealType;
+            break;
+        case token::STRING:
+            primitive = PType::PrimitiveTypeEnum::kStringType;
+            break;
+        case token::BOOLEAN:
+            primitive = PType::PrimitiveTypeEnum::kBoolType;
+            break;
+        default:
+            fail();
+        }
+        advance();
+        return TypeContext::getPrimitiveType(primitive);
+    }
+
+    ConstantValueNode *newConstant(const YYLTYPE &p_location,
+                                   const PType::PrimitiveTypeEnum p_primitive,
+                                   const Constant::ConstantValue &p_value) {
+        auto *const constant = newInArena<Constant>(
+            TypeContext::getPrimitiveType(p_primitive), p_value);
+        return newInArena<ConstantValueNode>(p_location.first_line,
+                                             p_location.first_column, constant);
+    }
+
+    // LiteralConstant: NegOrNot INT_LITERAL | NegOrNot REAL_LITERAL
+    //                  | StringAndBoolean
+    ConstantValueNode *parseLiteralConstant() {
+        if (m_token != token::MINUS) {
+            if (m_token == token::INT_LITERAL ||
+                m_token == token::REAL_LITERAL) {
+                return parseIntegerAndReal();
+            }
+            return parseStringAndBoolean();
+        }
+
+        const YYLTYPE location = m_location;
+        advance();
+        Constant::ConstantValue value;
+        switch (m_token) {
+        case token::INT_LITERAL:
+            value.integer = -static_cast<int64_t>(m_value.integer);
+            advance();
+            return newConstant(location,
+                               PType::PrimitiveTypeEnum::kIntegerType, value);
+        case token::REAL_LITERAL:
+            value.real = -m_value.real;
+            advance();
+            return newConstant(location, PType::PrimitiveTypeEnum::kRealType,
+                               value);
+        default:
+            fail();
+        }
+    }
+
+    ConstantValueNode *parseStringAndBoolean() {
+        const YYLTYPE location = m_location;
+        Constant::ConstantValue value;
+        switch (m_token) {
+        case token::STRING_LITERAL:
+            value.string = m_value.string;
+            advance();
+            return newConstant(location, PType::PrimitiveTypeEnum::kStringType,
+                               value);
+        case token::TRUE:
+        case token::FALSE:
+            value.boolean = m_value.boolean;
+            advance();
+            return newConstant(location, PType::PrimitiveTypeEnum::kBoolType,
+                               value);
+        default:
+            fail();
+        }
+    }
+
+    ConstantValueNode *parseIntegerAndReal() {
+        const YYLTYPE location = m_location;
+        Constant::ConstantValue value;
+        if (m_token == token::INT_LITERAL) {
+            value.integer = static_cast<int64_t>(m_value.integer);
+            advance();
+            return newConstant(location,
+                               PType::PrimitiveTypeEnum::kIntegerType, value);
+        }
+        value.real = m_value.real;
+        advance();
+        return newConstant(location, PType::PrimitiveTypeEnum::kRealType,
+                           value);
+    }
+
+    CompoundStatementNode *parseCompoundStatement() {
+        const NestingLevel level(*this);
+        const YYLTYPE location = m_location;
+        expect(token::BEGIN_);
+        const ArenaVector<DeclNode *> decls = parseDeclarationList();
+        ArenaVector<AstNode *> statements;
+        while (m_token != token::END) {
+            statements.push_back(parseStatement());
+        }
+        advance();
+        return newInArena<CompoundStatementNode>(
+            location.first_line, location.first_column, decls, statements);
+    }
+
+    AstNode *parseStatement() {
+        const YYLTYPE location = m_location;
+        switch (m_token) {
+        case token::BEGIN_:
+            return parseCompoundStatement();
+        case token::ID: {
+            const Atom name = m_value.identifier;
+            advance();
+            if (m_token == token::L_PARENTHESIS) {
+                AstNode *const invocation =
+                    parseFunctionInvocation(location, name);
+                expect(token::SEMICOLON);
+                return invocation;
+            }
+            VariableReferenceNode *const target =
+                parseVariableReference(location, name);
+            const YYLTYPE assign_location = m_location;
+            expect(token::ASSIGN);
+            ExpressionNode *const expression = parseExpression(0);
+            expect(token::SEMICOLON);
+            return newInArena<AssignmentNode>(assign_location.first_line,
+                                              assign_location.first_column,
+                                              target, expression);
+        }
+        case token::PRINT: {
+            advance();
+            ExpressionNode *const target = parseExpression(0);
+            expect(token::SEMICOLON);
+            return newInArena<PrintNode>(location.first_line,
+                                         location.first_column, target);
+        }
+        case token::READ: {
+            advance();
+            const YYLTYPE target_location = m_location;
+            const Atom name = expectId();
+            VariableReferenceNode *const target =
+                parseVariableReference(target_location, name);
+            expect(token::SEMICOLON);
+            return newInArena<ReadNode>(location.first_line,
+                                        location.first_column, target);
+        }
+        case token::IF: {
+            advance();
+            ExpressionNode *const condition = parseExpression(0);
+            expect(token::THEN);
+            CompoundStatementNode *const body = parseCompoundStatement();
+            CompoundStatementNode *else_body = nullptr;
+            if (m_token == token::ELSE) {
+                advance();
+                else_body = parseCompoundStatement();
+            }
+            expect(token::END);
+            expect(token::IF);
+            return newInArena<IfNode>(location.first_line,
+                                      location.first_column, condition, body,
+                                      else_body);
+        }
+        case token::WHILE: {
+            advance();
+            ExpressionNode *const condition = parseExpression(0);
+            expect(token::DO);
+            CompoundStatementNode *const body = parseCompoundStatement();
+            expect(token::END);
+            expect(token::DO);
+            return newInArena<WhileNode>(location.first_line,
+                                         location.first_column, condition,
+                                         body);
+        }
+        case token::FOR:
+            return parseFor();
+        case token::RETURN: {
+            advance();
+            ExpressionNode *const value = parseExpression(0);
+            expect(token::SEMICOLON);
+            return newInArena<ReturnNode>(location.first_line,
+                                          location.first_column, value);
+        }
+        default:
+            fail();
+        }
+    }
+
+    // FOR ID ASSIGN INT_LITERAL TO INT_LITERAL DO CompoundStatement END DO,
+    // with the nodes that parser.y makes of it
+    ForNode *parseFor() {
+        const YYLTYPE location = m_location;
+        expect(token::FOR);
+        const YYLTYPE id_location = m_location;
+        const Atom id = expectId();
+        const YYLTYPE assign_location = m_location;
+        expect(token::ASSIGN);
+        const YYLTYPE begin_location = m_location;
+        const uint32_t begin = expectIntLiteral();
+        expect(token::TO);
+        const YYLTYPE end_location = m_location;
+        const uint32_t end = expectIntLiteral();
+        expect(token::DO);
+        CompoundStatementNode *const body = parseCompoundStatement();
+        expect(token::END);
+        expect(token::DO);
+
+        ArenaVector<IdInfo> ids;
+        ids.emplace_back(id_location.first_line, id_location.first_column, id);
+        auto *const var_decl =
+            newInArena<DeclNode>(id_location.first_line,
+                                 id_location.first_column, ids,
+                                 TypeContext::kIntegerType);
+
+        auto *const var_ref = newInArena<VariableReferenceNode>(
+            id_location.first_line, id_location.first_column, id);
+        Constant::ConstantValue value;
+        value.integer = static_cast<int64_t>(begin);
+        auto *const assignment = newInArena<AssignmentNode>(
+            assign_location.first_line, assign_location.first_column, var_ref,
+            newConstant(begin_location,
+                        PType::PrimitiveTypeEnum::kIntegerType, value));
+
+        value.integer = static_cast<int64_t>(end);
+        return newInArena<ForNode>(
+            location.first_line, location.first_column, var_decl, assignment,
+            newConstant(end_location, PType::PrimitiveTypeEnum::kIntegerType,
+                        value),
+            body);
+    }
+
+    // the rest of `ID ArrRefList`, after the ID
+    VariableReferenceNode *parseVariableReference(const YYLTYPE &p_location,
+                                                  const Atom p_name) {
+        ArenaVector<ExpressionNode *> indices;
+        while (m_token == token::L_BRACKET) {
+            advance();
+            indices.push_back(parseExpression(0));
+            expect(token::R_BRACKET);
+        }
+        return newInArena<VariableReferenceNode>(
+            p_location.first_line, p_location.first_column, p_name, indices);
+    }
+
+    // the rest of `ID L_PARENTHESIS ExpressionList R_PARENTHESIS`
+    FunctionInvocationNode *parseFunctionInvocation(const YYLTYPE &p_location,
+                                                    const Atom p_name) {
+        expect(token::L_PARENTHESIS);
+        ArenaVector<ExpressionNode *> args;
+        if (m_token != token::R_PARENTHESIS) {
+            args.push_back(parseExpression(0));
+            while (m_token == token::COMMA) {
+                advance();
+                args.push_back(parseExpression(0));
+            }
+        }
+        expect(token::R_PARENTHESIS);
+        return newInArena<FunctionInvocationNode>(
+            p_location.first_line, p_location.first_column, p_name, args);
+    }
+
+    // An operand, then the binary operators of at least p_precedence, each
+    // with an operand of the operators above its own level. A chain of
+    // left-associative operators is a loop, not a recursion.
+    ExpressionNode *parseExpression(const int p_precedence) {
+        const NestingLevel level(*this);
+        ExpressionNode *left = parseOperand();
+        for (;;) {
+            const BinaryOperator binary = lookUpBinaryOperator(m_token);
+            if (binary.precedence == 0 || binary.precedence < p_precedence) {
+                return left;
+            }
+            const YYLTYPE location = m_location;
+            advance();
+            ExpressionNode *const right =
+                parseExpression(binary.precedence + 1);
+            left = newInArena<BinaryOperatorNode>(location.first_line,
+                                                  location.first_column,
+                                                  binary.op, left, right);
+        }
+    }
+
+    ExpressionNode *parseOperand() {
+        const YYLTYPE location = m_location;
+        switch (m_token) {
+        case token::L_PARENTHESIS: {
+            advance();
+            ExpressionNode *const expression = parseExpression(0);
+            expect(token::R_PARENTHESIS);
+            return expression;
+        }
+        case token::MINUS: {
+            advance();
+            ExpressionNode *const operand =
+                parseExpression(kUnaryMinusPrecedence);
+            return newInArena<UnaryOperatorNode>(location.first_line,
+                                                 location.first_column,
+                                                 Operator::kNegOp, operand);
+        }
+        case token::NOT: {
+            advance();
+            ExpressionNode *const operand = parseExpression(kNotPrecedence);
+            return newInArena<UnaryOperatorNode>(location.first_line,
+                                                 location.first_column,
+                                                 Operator::kNotOp, operand);
+        }
+        case token::INT_LITERAL:
+        case token::REAL_LITERAL:
+            return parseIntegerAndReal();
+        case token::STRING_LITERAL:
+        case token::TRUE:
+        case token::FALSE:
+            return parseStringAndBoolean();
+        case token::ID: {
+            const Atom name = m_value.identifier;
+            advance();
+            if (m_token == token::L_PARENTHESIS) {
+                return parseFunctionInvocation(location, name);
+            }
+            return parseVariableReference(location, name);
+        }
+        default:
+            fail();
+        }
+    }
+};
+
+} // namespace
+
+bool parseProgramByDescent(CompilationContext &context) {
+    DescentParser parser(context);
+    try {
+        parser.parseStart();
+    } catch (const SyntaxError &) {
+        return false;
+    }
+    // a bad character makes nextParserToken() end the input, which the
+    // grammar may accept
+    return !context.has_error;
+}
@@ -1,40 +1,54 @@
 #ifndef AST_AST_DUMPER_H
 #define AST_AST_DUMPER_H
 
-#include "visitor/AstNodeVisitor.hpp"
+#include "util/OutputBuffer.hpp"
+#include "visitor/AstWalker.hpp"
 
 #include <cstdint>
+#include <cstdio>
 
-class AstDumper final : public AstNodeVisitor {
+// Dumps a tree with AstWalker::walk(), indenting the children of a node
+// under it. The dump reaches p_output when the dumper is destroyed.
+class AstDumper final : public AstWalker<AstDumper> {
   private:
+    OutputBuffer m_output;
     uint32_t m_indentation_stride = 2;
     uint32_t m_indentation = 0;
 
   public:
     ~AstDumper() = default;
-    AstDumper() = default;
-
-    void visit(ProgramNode &p_program) override;
-    void visit(DeclNode &p_decl) override;
-    void visit(VariableNode &p_variable) override;
-    void visit(ConstantValueNode &p_constant_value) override;
-    void visit(FunctionNode &p_function) override;
-    void visit(CompoundStatementNode &p_compound_statement) override;
-    void visit(PrintNode &p_print) override;
-    void visit(BinaryOperatorNode &p_bin_op) override;
-    void visit(UnaryOperatorNode &p_un_op) override;
-    void visit(FunctionInvocationNode &p_func_invocation) override;
-    void visit(VariableReferenceNode &p_variable_ref) override;
-    void visit(AssignmentNode &p_assignment) override;
-    void visit(ReadNode &p_read) override;
-    void visit(IfNode &p_if) override;
-    void visit(WhileNode &p_while) override;
-    void visit(ForNode &p_for) override;
-    void visit(ReturnNode &p_return) override;
+    explicit AstDumper(FILE *const p_output = stdout) : m_output(p_output) {}
+
+    void preVisit(ProgramNode &p_program);
+    void preVisit(DeclNode &p_decl);
+    void preVisit(VariableNode &p_variable);
+    void preVisit(ConstantValueNode &p_constant_value);
+    void preVisit(FunctionNode &p_function);
+    void preVisit(CompoundStatementNode &p_compound_statement);
+    void preVisit(PrintNode &p_print);
+    void preVisit(BinaryOperatorNode &p_bin_op);
+    void preVisit(UnaryOperatorNode &p_un_op);
+    void preVisit(FunctionInvocationNode &p_func_invocation);
+    void preVisit(VariableReferenceNode &p_variable_ref);
+    void preVisit(AssignmentNode &p_assignment);
+    void preVisit(ReadNode &p_read);
+    void preVisit(IfNode &p_if);
+    void preVisit(WhileNode &p_while);
+    void preVisit(ForNode &p_for);
+    void preVisit(ReturnNode &p_return);
+
+    // back to the indentation of the node; a ConstantValueNode, which has
+    // no children, did not indent
+    template <typename Node> void postVisit(Node &) { decrementIndentation(); }
+    void postVisit(ConstantValueNode &) {}
 
   private:
     void incrementIndentation();
     void decrementIndentation();
+    // the indentation and e.g. "program <line: 1, col: 1>"; the caller
+    // writes the rest of the line
+    void outputNodeHeader(const char *const p_name,
+                          const Location &p_location);
 };
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef AST_AST_FILE_H
+#define AST_AST_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+class ProgramNode;
+
+// The AST in a binary form that holds no pointers, for the AST cache (see
+// driver/AstCache.hpp): a run of 32-bit words that can be written to a file
+// and mapped back in at any address.
+//
+// The words hold the identifiers, string literals and array types of the
+// tables the tree refers to, each table in the order of its ids, then the
+// nodes in preorder. A node is its AstNodeKind, line and column, the fields
+// of its class, the number of its children and then the children. A
+// DeclNode holds its variables as names and locations rather than as
+// children; its only child is the constant, if any.
+
+// Appends the program and the tables of getInstance() it refers to.
+void writeAst(ProgramNode &p_program, std::vector<uint32_t> &p_words);
+
+// what an AST file starts with, before kAstFileVersion and the number of
+// words that follow
+constexpr char kAstFileMagic[4] = {'P', 'A', 'S', 'T'};
+// raise when the words that writeAst() writes change
+constexpr uint32_t kAstFileVersion = 1;
+
+// Writes an AST file: the header, then the words of writeAst(), in the byte
+// order of the machine (--dump-ast=bin).
+void writeAstFile(ProgramNode &p_program, FILE *const p_output);
+
+// Rebuilds a program that writeAst() wrote into the arena and the tables of
+// getInstance(). Returns null if the words are not such a program, e.g.
+// because the file was damaged; what was rebuilt until then stays in the
+// arena and the tables.
+ProgramNode *readAst(const uint32_t *const p_words,
+                     const size_t p_num_of_words);
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef AST_AST_JSON_DUMPER_H
+#define AST_AST_JSON_DUMPER_H
+
+#include "util/OutputBuffer.hpp"
+#include "visitor/AstWalker.hpp"
+
+#include <cstdio>
+
+// Dumps a tree as one line of JSON (--dump-ast=json): a node is an object
+// with its "kind", "line" and "col", the fields that the text dump prints
+// for it, and its "children" in an array, e.g.
+//   {"kind":"variable","line":3,"col":5,"name":"a","type":"integer",
+//    "children":[]}
+// A constant_value has no "children". An expression also has the
+// "result_type" that SemanticAnalyzer recorded, null if it has none, and a
+// variable_reference or function_invocation the "declaration" it refers
+// to, as {"line":1,"col":5} or null. The dump reaches p_output when the
+// dumper is destroyed.
+class AstJsonDumper final : public AstWalker<AstJsonDumper> {
+  private:
+    OutputBuffer m_output;
+    // whether the next node is the first of its array, with no ',' before
+    bool m_is_first = true;
+
+  public:
+    ~AstJsonDumper() = default;
+    explicit AstJsonDumper(FILE *const p_output = stdout)
+        : m_output(p_output) {}
+
+    void preVisit(ProgramNode &p_program);
+    void preVisit(DeclNode &p_decl);
+    void preVisit(VariableNode &p_variable);
+    void preVisit(ConstantValueNode &p_constant_value);
+    void preVisit(FunctionNode &p_function);
+    void preVisit(CompoundStatementNode &p_compound_statement);
+    void preVisit(PrintNode &p_print);
+    void preVisit(BinaryOperatorNode &p_bin_op);
+    void preVisit(UnaryOperatorNode &p_un_op);
+    void preVisit(FunctionInvocationNode &p_func_invocation);
+    void preVisit(VariableReferenceNode &p_variable_ref);
+    void preVisit(AssignmentNode &p_assignment);
+    void preVisit(ReadNode &p_read);
+    void preVisit(IfNode &p_if);
+    void preVisit(WhileNode &p_while);
+    void preVisit(ForNode &p_for);
+    void preVisit(ReturnNode &p_return);
+
+    // closes the children and the node; a ConstantValueNode closed itself
+    template <typename Node> void postVisit(Node &) { closeNode(); }
+    void postVisit(ConstantValueNode &) {}
+    void postVisit(ProgramNode &);
+
+  private:
+    // e.g. {"kind":"program","line":1,"col":1 without the closing brace
+    void openNode(const char *const p_kind, const Location &p_location);
+    // e.g. ,"name":"a"
+    void outputField(const char *const p_name, const char *const p_value);
+    void openChildren();
+    void closeNode();
+    // with the quotes, escaping what JSON does not allow in a string as is
+    // and each byte that is not part of valid UTF-8
+    void outputString(const char *p_string);
+    void outputResultType(const ExpressionNode &p_expression);
+    void outputDeclaration(const AstNode *const p_declaration);
+};
+
+#endif
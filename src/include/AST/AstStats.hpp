@@ -0,0 +1,58 @@
+#ifndef AST_AST_STATS_H
+#define AST_AST_STATS_H
+
+#include "AST/ast.hpp"
+#include "visitor/AstWalker.hpp"
+
+#include <cstddef>
+#include <cstdio>
+
+// Where the memory of a tree goes (--stats=ast): for each class of node,
+// how many there are, their sizeof and what they own outside of
+// themselves, such as the arrays of their lists, the prototype of a
+// function and the Constant of a ConstantValueNode. All of it is in the
+// arena; names and string literals are in the tables of the compilation,
+// which nodes share, and are not counted.
+class AstStats final : public AstWalker<AstStats> {
+  private:
+    struct ClassStats {
+        size_t num_of_nodes = 0;
+        size_t num_of_owned_bytes = 0;
+    };
+    ClassStats m_classes[kNumOfAstNodeKinds];
+    // the variables of a constant declaration share its ConstantValueNode,
+    // which they visit one after the other
+    const ConstantValueNode *m_last_constant_value = nullptr;
+
+  public:
+    template <typename Node> void preVisit(Node &p_node) {
+        add(Node::kKind, getNumOfOwnedBytes(p_node, 0));
+    }
+    void preVisit(ConstantValueNode &p_constant_value);
+
+    // A table of the classes and a summary, with the bytes per line of a
+    // source of p_num_of_lines lines and the bytes in the arena of
+    // Arena::getInstance(), which also holds the lists the parser built
+    // the nodes' lists from.
+    void report(FILE *const p_output, const size_t p_num_of_lines) const;
+
+  private:
+    template <typename Node>
+    static auto getNumOfOwnedBytes(const Node &p_node, int)
+        -> decltype(p_node.getNumOfOwnedBytes()) {
+        return p_node.getNumOfOwnedBytes();
+    }
+    // for the classes that own nothing and have no getNumOfOwnedBytes()
+    template <typename Node>
+    static size_t getNumOfOwnedBytes(const Node &, long) {
+        return 0;
+    }
+
+    void add(const AstNodeKind p_kind, const size_t p_num_of_owned_bytes) {
+        ClassStats &stats = m_classes[static_cast<size_t>(p_kind)];
+        ++stats.num_of_nodes;
+        stats.num_of_owned_bytes += p_num_of_owned_bytes;
+    }
+};
+
+#endif
@@ -5,26 +5,35 @@
 #include "AST/operator.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
+#include <cstddef>
 
 class BinaryOperatorNode final : public ExpressionNode {
   private:
     Operator m_op;
-    std::unique_ptr<ExpressionNode> m_left_operand;
-    std::unique_ptr<ExpressionNode> m_right_operand;
+    ExpressionNode *m_left_operand;
+    ExpressionNode *m_right_operand;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kBinaryOperator;
+
     ~BinaryOperatorNode() = default;
     BinaryOperatorNode(const uint32_t line, const uint32_t col, Operator op,
                        ExpressionNode *p_left_operand,
                        ExpressionNode *p_right_operand)
-        : ExpressionNode{line, col}, m_op(op), m_left_operand(p_left_operand),
-          m_right_operand(p_right_operand) {}
+        : ExpressionNode{kKind, line, col}, m_op(op),
+          m_left_operand(p_left_operand), m_right_operand(p_right_operand) {}
 
+    Operator getOp() const { return m_op; }
     const char *getOpCString() const {
         return kOpString[static_cast<size_t>(m_op)];
     }
 
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        p_callback(*m_left_operand);
+        p_callback(*m_right_operand);
+    }
+
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
 };
@@ -3,25 +3,42 @@
 
 #include "AST/ast.hpp"
 #include "AST/decl.hpp"
-
-#include <vector>
-#include <memory>
+#include "util/Arena.hpp"
 
 class CompoundStatementNode final : public AstNode {
   public:
-    using DeclNodes = std::vector<std::unique_ptr<DeclNode>>;
-    using StmtNodes = std::vector<std::unique_ptr<AstNode>>;
+    using DeclNodes = ArenaVector<DeclNode *>;
+    using StmtNodes = ArenaVector<AstNode *>;
 
   private:
     DeclNodes m_decl_nodes;
     StmtNodes m_stmt_nodes;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kCompoundStatement;
+
     ~CompoundStatementNode() = default;
     CompoundStatementNode(const uint32_t line, const uint32_t col,
-                          DeclNodes &p_decl_nodes, StmtNodes &p_stmt_nodes)
-        : AstNode{line, col}, m_decl_nodes(std::move(p_decl_nodes)),
-          m_stmt_nodes(std::move(p_stmt_nodes)){}
+                          const DeclNodes &p_decl_nodes,
+                          const StmtNodes &p_stmt_nodes)
+        : AstNode{kKind, line, col}, m_decl_nodes(p_decl_nodes),
+          m_stmt_nodes(p_stmt_nodes){}
+
+    // the lists of declarations and statements, in the arena
+    size_t getNumOfOwnedBytes() const {
+        return m_decl_nodes.getNumOfArenaBytes() +
+               m_stmt_nodes.getNumOfArenaBytes();
+    }
+
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        for (auto *const decl : m_decl_nodes) {
+            p_callback(*decl);
+        }
+        for (auto *const stmt : m_stmt_nodes) {
+            p_callback(*stmt);
+        }
+    }
 
     void accept(AstNodeVisitor &p_visitor) override {
         p_visitor.visit(*this);
@@ -6,26 +6,32 @@
 #include "AST/expression.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
-
 class ConstantValueNode final : public ExpressionNode {
   private:
-    std::unique_ptr<Constant> m_constant_ptr;
+    Constant *m_constant_ptr;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kConstantValue;
+
     ~ConstantValueNode() = default;
     ConstantValueNode(const uint32_t line, const uint32_t col,
                       Constant *const p_constant)
-        : ExpressionNode{line, col}, m_constant_ptr(p_constant) {}
+        : ExpressionNode{kKind, line, col}, m_constant_ptr(p_constant) {}
 
-    const PTypeSharedPtr &getTypeSharedPtr() const {
-        return m_constant_ptr->getTypeSharedPtr();
+    TypeId getType() const { return m_constant_ptr->getType(); }
+    const Constant &getConstant() const { return *m_constant_ptr; }
+    // the Constant, in the arena
+    size_t getNumOfOwnedBytes() const {
+        return sizeof(Constant) + m_constant_ptr->getNumOfOwnedBytes();
     }
 
     const char *getConstantValueCString() const {
         return m_constant_ptr->getConstantValueCString();
     }
 
+    // has no children
+    template <typename Callback> void forEachChild(Callback &&) {}
+
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
 };
 
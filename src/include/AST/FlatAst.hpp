@@ -0,0 +1,223 @@
+#ifndef AST_FLAT_AST_H
+#define AST_FLAT_AST_H
+
+#include "AST/PType.hpp"
+#include "AST/ast.hpp"
+#include "AST/operator.hpp"
+#include "util/StringInterner.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class FlatAstVisitor;
+
+// The AST laid out flat, for passes that walk the whole tree: the nodes of
+// each kind are stored by value in an array of their own, in the order a
+// traversal visits them, and refer to their children by 32-bit NodeIds
+// instead of pointers. The locations are kept in arrays parallel to those.
+// There is no vtable and no allocation per node; a node takes a third to a
+// half of the memory of its AstNode.
+//
+// It is built from the AST the parser made and holds what a visitor of
+// that AST can learn from it (see FlatAstVisitor). Names and types are
+// atoms and TypeIds of the compilation; the strings the AST builds on
+// demand (prototypes, constant values) are copied into the FlatAst.
+class FlatAst {
+  public:
+    // the classes of AstNode
+    using Kind = AstNodeKind;
+    static constexpr size_t kNumOfKinds = kNumOfAstNodeKinds;
+
+    // the kind in the top bits, the index into the array of the kind in
+    // the others
+    using NodeId = uint32_t;
+    static constexpr uint32_t kIndexBits = 27;
+    static constexpr NodeId kNoNode = UINT32_MAX;
+
+    // an offset into the strings of the FlatAst
+    using StringId = uint32_t;
+
+    // a run of the NodeIds in the list pool
+    struct NodeList {
+        uint32_t first;
+        uint32_t size;
+    };
+
+    // The nodes, one struct per class of AST node. An absent child is
+    // kNoNode.
+    struct Program {
+        static constexpr Kind kKind = Kind::kProgram;
+        Atom name;
+        NodeList decls;
+        NodeList functions;
+        NodeId body;
+    };
+    struct Decl {
+        static constexpr Kind kKind = Kind::kDecl;
+        NodeList variables;
+    };
+    struct Variable {
+        static constexpr Kind kKind = Kind::kVariable;
+        Atom name;
+        TypeId type;
+        // shared by the variables of a declaration
+        NodeId constant;
+    };
+    struct ConstantValue {
+        static constexpr Kind kKind = Kind::kConstantValue;
+        StringId value;
+        TypeId type;
+    };
+    struct Function {
+        static constexpr Kind kKind = Kind::kFunction;
+        Atom name;
+        StringId prototype;
+        NodeList parameters;
+        NodeId body;
+    };
+    struct CompoundStatement {
+        static constexpr Kind kKind = Kind::kCompoundStatement;
+        NodeList decls;
+        NodeList statements;
+    };
+    struct Print {
+        static constexpr Kind kKind = Kind::kPrint;
+        NodeId target;
+    };
+    struct BinaryOperator {
+        static constexpr Kind kKind = Kind::kBinaryOperator;
+        Operator op;
+        NodeId left_operand;
+        NodeId right_operand;
+    };
+    struct UnaryOperator {
+        static constexpr Kind kKind = Kind::kUnaryOperator;
+        Operator op;
+        NodeId operand;
+    };
+    struct FunctionInvocation {
+        static constexpr Kind kKind = Kind::kFunctionInvocation;
+        Atom name;
+        NodeList arguments;
+    };
+    struct VariableReference {
+        static constexpr Kind kKind = Kind::kVariableReference;
+        Atom name;
+        NodeList indices;
+    };
+    struct Assignment {
+        static constexpr Kind kKind = Kind::kAssignment;
+        NodeId lvalue;
+        NodeId expr;
+    };
+    struct Read {
+        static constexpr Kind kKind = Kind::kRead;
+        NodeId target;
+    };
+    struct If {
+        static constexpr Kind kKind = Kind::kIf;
+        NodeId condition;
+        NodeId body;
+        NodeId else_body;
+    };
+    struct While {
+        static constexpr Kind kKind = Kind::kWhile;
+        NodeId condition;
+        NodeId body;
+    };
+    struct For {
+        static constexpr Kind kKind = Kind::kFor;
+        NodeId loop_var_decl;
+        NodeId init_stmt;
+        NodeId end_condition;
+        NodeId body;
+    };
+    struct Return {
+        static constexpr Kind kKind = Kind::kReturn;
+        NodeId ret_val;
+    };
+
+    // for range-based for over a NodeList
+    struct NodeRange {
+        const NodeId *m_begin;
+        const NodeId *m_end;
+
+        const NodeId *begin() const { return m_begin; }
+        const NodeId *end() const { return m_end; }
+    };
+
+  private:
+    // in the order of Kind
+    std::tuple<std::vector<Program>, std::vector<Decl>, std::vector<Variable>,
+               std::vector<ConstantValue>, std::vector<Function>,
+               std::vector<CompoundStatement>, std::vector<Print>,
+               std::vector<BinaryOperator>, std::vector<UnaryOperator>,
+               std::vector<FunctionInvocation>,
+               std::vector<VariableReference>, std::vector<Assignment>,
+               std::vector<Read>, std::vector<If>, std::vector<While>,
+               std::vector<For>, std::vector<Return>>
+        m_nodes;
+    std::vector<Location> m_locations[kNumOfKinds];
+    std::vector<NodeId> m_lists;
+    // NUL-terminated, each string once
+    std::string m_strings;
+    NodeId m_root = kNoNode;
+
+    friend class FlatAstBuilder;
+
+  public:
+    ~FlatAst() = default;
+    // Flattens the tree under p_root, which is usually a ProgramNode. Lazy
+    // function bodies are parsed.
+    explicit FlatAst(AstNode &p_root);
+
+    FlatAst(const FlatAst &) = delete;
+    FlatAst &operator=(const FlatAst &) = delete;
+
+    NodeId getRoot() const { return m_root; }
+
+    static Kind getKind(const NodeId p_id) {
+        return static_cast<Kind>(p_id >> kIndexBits);
+    }
+    static uint32_t getIndex(const NodeId p_id) {
+        return p_id & ((uint32_t{1} << kIndexBits) - 1);
+    }
+
+    // p_id has to be of Node::kKind
+    template <typename Node> const Node &get(const NodeId p_id) const {
+        return std::get<std::vector<Node>>(m_nodes)[getIndex(p_id)];
+    }
+    const Location &getLocation(const NodeId p_id) const {
+        return m_locations[static_cast<size_t>(getKind(p_id))]
+                          [getIndex(p_id)];
+    }
+    NodeRange getNodes(const NodeList p_list) const {
+        const NodeId *const first = m_lists.data() + p_list.first;
+        return {first, first + p_list.size};
+    }
+    const char *getCString(const StringId p_string) const {
+        return m_strings.data() + p_string;
+    }
+
+    // Calls the visit() of p_visitor for the node.
+    void accept(const NodeId p_id, FlatAstVisitor &p_visitor) const;
+    // Calls the visit() of p_visitor for the node and the nodes under it in
+    // the order AstNode::visitChildNodes() does, and its leave() for each
+    // once the nodes under it are visited. Like AstWalker, it keeps a stack
+    // of its own, so a deep tree takes no more native stack than a flat one.
+    void walk(const NodeId p_root, FlatAstVisitor &p_visitor) const;
+
+    size_t getNumOfNodes() const;
+    // what the arrays take, with the room they have left
+    size_t getNumOfBytes() const;
+
+  private:
+    // calls p_callback with the id of each child, in the order of walk()
+    template <typename Callback>
+    void forEachChild(const NodeId p_id, Callback &&p_callback) const;
+};
+
+#endif
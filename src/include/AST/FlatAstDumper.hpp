@@ -0,0 +1,56 @@
+#ifndef AST_FLAT_AST_DUMPER_H
+#define AST_FLAT_AST_DUMPER_H
+
+#include "AST/FlatAst.hpp"
+#include "visitor/FlatAstVisitor.hpp"
+
+#include <cstdint>
+#include <cstdio>
+
+// AstDumper for a FlatAst, with the same output
+class FlatAstDumper final : public FlatAstVisitor {
+  private:
+    const FlatAst &m_ast;
+    FILE *m_output;
+    uint32_t m_indentation_stride = 2;
+    uint32_t m_indentation = 0;
+
+  public:
+    ~FlatAstDumper() = default;
+    explicit FlatAstDumper(const FlatAst &p_ast, FILE *const p_output = stdout)
+        : m_ast(p_ast), m_output(p_output) {}
+
+    void visit(NodeId p_id, const FlatAst::Program &p_program) override;
+    void visit(NodeId p_id, const FlatAst::Decl &p_decl) override;
+    void visit(NodeId p_id, const FlatAst::Variable &p_variable) override;
+    void visit(NodeId p_id,
+               const FlatAst::ConstantValue &p_constant_value) override;
+    void visit(NodeId p_id, const FlatAst::Function &p_function) override;
+    void
+    visit(NodeId p_id,
+          const FlatAst::CompoundStatement &p_compound_statement) override;
+    void visit(NodeId p_id, const FlatAst::Print &p_print) override;
+    void visit(NodeId p_id, const FlatAst::BinaryOperator &p_bin_op) override;
+    void visit(NodeId p_id, const FlatAst::UnaryOperator &p_un_op) override;
+    void
+    visit(NodeId p_id,
+          const FlatAst::FunctionInvocation &p_func_invocation) override;
+    void visit(NodeId p_id,
+               const FlatAst::VariableReference &p_variable_ref) override;
+    void visit(NodeId p_id, const FlatAst::Assignment &p_assignment) override;
+    void visit(NodeId p_id, const FlatAst::Read &p_read) override;
+    void visit(NodeId p_id, const FlatAst::If &p_if) override;
+    void visit(NodeId p_id, const FlatAst::While &p_while) override;
+    void visit(NodeId p_id, const FlatAst::For &p_for) override;
+    void visit(NodeId p_id, const FlatAst::Return &p_return) override;
+
+    // the nodes under it are done
+    void leave(NodeId p_id) override;
+
+  private:
+    // the indentation and the start of the line of a node, then indents the
+    // nodes under it; the caller writes the rest
+    void outputNodeHeader(const char *const p_name, const NodeId p_id);
+};
+
+#endif
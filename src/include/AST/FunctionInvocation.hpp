@@ -2,29 +2,53 @@
 #define AST_FUNCTION_INVOCATION_NODE_H
 
 #include "AST/expression.hpp"
+#include "util/Arena.hpp"
+#include "util/StringInterner.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
-#include <string>
-#include <vector>
+class FunctionNode;
 
 class FunctionInvocationNode final : public ExpressionNode
 {
 public:
-  using ExprNodes = std::vector<std::unique_ptr<ExpressionNode>>;
+  using ExprNodes = ArenaVector<ExpressionNode *>;
 
 private:
-  std::string m_name;
+  Atom m_name;
   ExprNodes m_args;
+  std::atomic<const FunctionNode *> m_function{nullptr};
 
 public:
+  static constexpr AstNodeKind kKind = AstNodeKind::kFunctionInvocation;
+
   ~FunctionInvocationNode() = default;
   FunctionInvocationNode(const uint32_t line, const uint32_t col,
-                         const char *const p_name, ExprNodes &p_args)
-      : ExpressionNode{line, col}, m_name(p_name), m_args(std::move(p_args)) {}
+                         const Atom p_name, const ExprNodes &p_args)
+      : ExpressionNode{kKind, line, col}, m_name(p_name), m_args(p_args) {}
 
-  const char *getNameCString() const { return m_name.c_str(); }
+  Atom getName() const { return m_name; }
+  const char *getNameCString() const { return getAtomCString(m_name); }
   size_t getNumOfArguments() { return m_args.size(); }
+  // the arguments beyond the first, in the arena
+  size_t getNumOfOwnedBytes() const { return m_args.getNumOfArenaBytes(); }
+
+  // the function called, once SemanticAnalyzer has found it; null before,
+  // and if the name is undeclared or not of a function
+  const FunctionNode *getFunction() const
+  {
+    return m_function.load(std::memory_order_relaxed);
+  }
+  void setFunction(const FunctionNode *const p_function)
+  {
+    m_function.store(p_function, std::memory_order_relaxed);
+  }
+
+  // calls p_callback with each child, in the order of visitChildNodes()
+  template <typename Callback> void forEachChild(Callback &&p_callback) {
+    for (auto *const arg : m_args) {
+      p_callback(*arg);
+    }
+  }
 
   void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
   void visitChildNodes(AstNodeVisitor &p_visitor) override;
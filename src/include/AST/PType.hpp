@@ -1,14 +1,24 @@
 #ifndef AST_P_TYPE_H
 #define AST_P_TYPE_H
 
+#include "util/ScopedInstance.hpp"
+
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
-class PType;
-
-using PTypeSharedPtr = std::shared_ptr<PType>;
+// A small integer standing for a type interned in a TypeContext. Two types
+// are equal if and only if their ids are.
+using TypeId = uint32_t;
 
+// A type: a primitive type with the dimensions of an array, if it is one.
+// Each distinct type exists once, in a TypeContext, and is immutable; its
+// string, the type of its elements and the type one index into it gives
+// are found when it is interned.
 class PType {
   public:
     enum class PrimitiveTypeEnum : uint8_t {
@@ -22,19 +32,91 @@ class PType {
   private:
     PrimitiveTypeEnum m_type;
     std::vector<uint64_t> m_dimensions;
-    mutable std::string m_type_string;
-    mutable bool m_type_string_is_valid = false;
+    TypeId m_element_type;
+    TypeId m_sub_array_type;
+    std::string m_type_string;
 
   public:
     ~PType() = default;
-    PType(const PrimitiveTypeEnum type) : m_type(type) {}
+    PType(const PrimitiveTypeEnum p_type, std::vector<uint64_t> p_dimensions,
+          const TypeId p_element_type, const TypeId p_sub_array_type,
+          std::string p_type_string)
+        : m_type(p_type), m_dimensions(std::move(p_dimensions)),
+          m_element_type(p_element_type), m_sub_array_type(p_sub_array_type),
+          m_type_string(std::move(p_type_string)) {}
 
-    void setDimensions(std::vector<uint64_t> &p_dims) {
-        m_dimensions = std::move(p_dims);
-    }
+    PType(const PType &) = delete;
+    PType &operator=(const PType &) = delete;
 
     PrimitiveTypeEnum getPrimitiveType() const { return m_type; }
-    const char *getPTypeCString() const;
+    const std::vector<uint64_t> &getDimensions() const {
+        return m_dimensions;
+    }
+    size_t getNumOfDimensions() const { return m_dimensions.size(); }
+    bool isArray() const { return !m_dimensions.empty(); }
+
+    // the primitive type, for an array as well as for a scalar
+    TypeId getElementType() const { return m_element_type; }
+    // without the first dimension, e.g. integer [4] for integer [3][4];
+    // the element type for an array of one dimension, TypeContext::kNoType
+    // for a scalar
+    TypeId getSubArrayType() const { return m_sub_array_type; }
+
+    // e.g. "integer [3][4]"
+    const char *getPTypeCString() const { return m_type_string.c_str(); }
 };
 
+// Table that stores every distinct type once and hands out TypeIds for
+// them. getInstance() is the table of the running compilation (see
+// util/ScopedInstance.hpp).
+class TypeContext : public ScopedInstance<TypeContext> {
+  public:
+    // the type of an expression that has none, because of an error; its
+    // string is empty
+    static constexpr TypeId kNoType = 0;
+
+    // the primitive types, interned up front in the order of
+    // PType::PrimitiveTypeEnum
+    static constexpr TypeId kVoidType = 1;
+    static constexpr TypeId kIntegerType = 2;
+    static constexpr TypeId kRealType = 3;
+    static constexpr TypeId kBoolType = 4;
+    static constexpr TypeId kStringType = 5;
+
+    static constexpr TypeId getPrimitiveType(PType::PrimitiveTypeEnum p_type) {
+        return kVoidType + static_cast<TypeId>(p_type);
+    }
+
+  private:
+    std::vector<std::unique_ptr<PType>> m_types; // indexed by id
+    // the array types, keyed by their strings, which tell them apart
+    std::unordered_map<std::string_view, TypeId> m_array_types;
+
+  public:
+    ~TypeContext() = default;
+    // a private table; most code uses the one of getInstance()
+    TypeContext();
+    TypeContext(const TypeContext &) = delete;
+    TypeContext &operator=(const TypeContext &) = delete;
+
+    // an array of p_num_of_dimensions dimensions, outermost first, or the
+    // primitive type itself if there are none
+    TypeId intern(const PType::PrimitiveTypeEnum p_type,
+                  const uint64_t *const p_dimensions,
+                  const size_t p_num_of_dimensions);
+
+    const PType &getType(const TypeId p_type) const {
+        return *m_types[p_type];
+    }
+    size_t getNumOfTypes() const { return m_types.size(); }
+};
+
+inline const PType &getPType(const TypeId p_type) {
+    return TypeContext::getInstance().getType(p_type);
+}
+
+inline const char *getTypeCString(const TypeId p_type) {
+    return getPType(p_type).getPTypeCString();
+}
+
 #endif
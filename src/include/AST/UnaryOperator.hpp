@@ -5,23 +5,31 @@
 #include "AST/operator.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
+#include <cstddef>
 
 class UnaryOperatorNode final : public ExpressionNode {
   private:
     Operator m_op;
-    std::unique_ptr<ExpressionNode> m_operand;
+    ExpressionNode *m_operand;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kUnaryOperator;
+
     ~UnaryOperatorNode() = default;
     UnaryOperatorNode(const uint32_t line, const uint32_t col, Operator op,
                       ExpressionNode *p_operand)
-        : ExpressionNode{line, col}, m_op(op), m_operand(p_operand) {}
+        : ExpressionNode{kKind, line, col}, m_op(op), m_operand(p_operand) {}
 
+    Operator getOp() const { return m_op; }
     const char *getOpCString() const {
         return kOpString[static_cast<size_t>(m_op)];
     }
 
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        p_callback(*m_operand);
+    }
+
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
 };
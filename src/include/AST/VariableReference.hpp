@@ -2,38 +2,63 @@
 #define AST_VARIABLE_REFERENCE_NODE_H
 
 #include "AST/expression.hpp"
+#include "util/Arena.hpp"
+#include "util/StringInterner.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
-#include <string>
-#include <vector>
+class VariableNode;
 
 class VariableReferenceNode final : public ExpressionNode
 {
 public:
-  using ExprNodes = std::vector<std::unique_ptr<ExpressionNode>>;
+  using ExprNodes = ArenaVector<ExpressionNode *>;
 
 private:
-  std::string m_name;
+  Atom m_name;
   ExprNodes m_indices;
+  std::atomic<const VariableNode *> m_variable{nullptr};
 
 public:
+  static constexpr AstNodeKind kKind = AstNodeKind::kVariableReference;
+
   ~VariableReferenceNode() = default;
 
   // normal reference
   VariableReferenceNode(const uint32_t line, const uint32_t col,
-                        const char *const p_name)
-      : ExpressionNode{line, col}, m_name(p_name) {}
+                        const Atom p_name)
+      : ExpressionNode{kKind, line, col}, m_name(p_name) {}
 
   // array reference
   VariableReferenceNode(const uint32_t line, const uint32_t col,
-                        const char *const p_name, ExprNodes &p_indices)
-      : ExpressionNode{line, col}, m_name(p_name),
-        m_indices(std::move(p_indices)) {}
+                        const Atom p_name, const ExprNodes &p_indices)
+      : ExpressionNode{kKind, line, col}, m_name(p_name),
+        m_indices(p_indices) {}
 
-  const char *getNameCString() const { return m_name.c_str(); }
+  Atom getName() const { return m_name; }
+  const char *getNameCString() const { return getAtomCString(m_name); }
 
   size_t getNumOfDim() const { return m_indices.size(); }
+  // the indices beyond the first, in the arena
+  size_t getNumOfOwnedBytes() const { return m_indices.getNumOfArenaBytes(); }
+
+  // the variable, constant, parameter or loop variable referred to, once
+  // SemanticAnalyzer has found it; null before, and if the name is
+  // undeclared or not of one of those
+  const VariableNode *getVariable() const
+  {
+    return m_variable.load(std::memory_order_relaxed);
+  }
+  void setVariable(const VariableNode *const p_variable)
+  {
+    m_variable.store(p_variable, std::memory_order_relaxed);
+  }
+
+  // calls p_callback with each child, in the order of visitChildNodes()
+  template <typename Callback> void forEachChild(Callback &&p_callback) {
+    for (auto *const index : m_indices) {
+      p_callback(*index);
+    }
+  }
 
   void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
   void visitChildNodes(AstNodeVisitor &p_visitor) override;
@@ -5,18 +5,24 @@
 #include "AST/expression.hpp"
 #include "AST/VariableReference.hpp"
 
-#include <memory>
-
 class AssignmentNode final : public AstNode {
   private:
-    std::unique_ptr<VariableReferenceNode> m_lvalue;
-    std::unique_ptr<ExpressionNode> m_expr;
+    VariableReferenceNode *m_lvalue;
+    ExpressionNode *m_expr;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kAssignment;
+
     ~AssignmentNode() = default;
     AssignmentNode(const uint32_t line, const uint32_t col,
                    VariableReferenceNode *p_var_ref, ExpressionNode *p_expr)
-        : AstNode{line, col}, m_lvalue(p_var_ref), m_expr(p_expr){}
+        : AstNode{kKind, line, col}, m_lvalue(p_var_ref), m_expr(p_expr){}
+
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        p_callback(*m_lvalue);
+        p_callback(*m_expr);
+    }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
@@ -1,6 +1,7 @@
 #ifndef AST_AST_NODE_H
 #define AST_AST_NODE_H
 
+#include <cstddef>
 #include <cstdint>
 
 class AstNodeVisitor;
@@ -13,13 +14,51 @@ struct Location {
     Location(const uint32_t line, const uint32_t col) : line(line), col(col) {}
 };
 
+// The concrete classes of AstNode, for code that dispatches on a node
+// without a virtual call (see visitor/AstStaticVisitor.hpp). Each class
+// has its kind as kKind.
+enum class AstNodeKind : uint8_t {
+    kProgram,
+    kDecl,
+    kVariable,
+    kConstantValue,
+    kFunction,
+    kCompoundStatement,
+    kPrint,
+    kBinaryOperator,
+    kUnaryOperator,
+    kFunctionInvocation,
+    kVariableReference,
+    kAssignment,
+    kRead,
+    kIf,
+    kWhile,
+    kFor,
+    kReturn
+};
+constexpr size_t kNumOfAstNodeKinds = 17;
+
+// Nodes are created in an Arena (see util/Arena.hpp) and never destroyed,
+// so a node holds plain pointers to its children and its lists are
+// ArenaVectors.
+//
+// Once parsed, a tree is only read: what a node prints is built when it is
+// constructed, and only the atomic slots of ExpressionNode are filled in
+// later. So passes such as AstDumper and SemanticAnalyzer may walk one
+// tree on several threads at once, each thread in the Scopes of the tables
+// of the compilation (see CompileResult). The exception is a function body
+// that CompileOptions::lazy_function_bodies skipped, which the first pass to
+// reach it parses; one walk has to finish before the others start then.
 class AstNode {
   protected:
     Location location;
+    // in what the Location leaves of the last word
+    const AstNodeKind m_kind;
+
+    ~AstNode() = default;
 
   public:
-    virtual ~AstNode() = 0;
-    AstNode(const uint32_t line, const uint32_t col);
+    AstNode(const AstNodeKind p_kind, const uint32_t line, const uint32_t col);
 
     AstNode(const AstNode &) = delete;
     AstNode(AstNode &&) = delete;
@@ -27,6 +66,7 @@ class AstNode {
     AstNode &operator=(AstNode &&) = delete;
 
     const Location &getLocation() const;
+    AstNodeKind getKind() const { return m_kind; }
 
     virtual void accept(AstNodeVisitor &p_visitor) = 0;
     virtual void visitChildNodes(AstNodeVisitor &p_visitor){};
@@ -2,37 +2,55 @@
 #define AST_CONSTANT_H
 
 #include "AST/PType.hpp"
+#include "util/StringLiteralPool.hpp"
 
 #include <cstdint>
-#include <cstdlib>
+#include <cstring>
 
 class Constant {
   public:
     union ConstantValue {
         int64_t integer;
         double real;
-        char *string;
+        StringLiteralId string;
         bool boolean;
     };
 
   private:
-    PTypeSharedPtr m_type;
+    TypeId m_type;
     ConstantValue m_value;
-    mutable std::string m_constant_value_string;
-    mutable bool m_constant_value_string_is_valid = false;
+    // in the arena of Arena::getInstance() when constructed, so that a
+    // constant is never written to after; null for strings, which the pool
+    // has already
+    const char *m_constant_value_string;
+
+    static const char *makeConstantValueCString(const TypeId p_type,
+                                                const ConstantValue p_value);
 
   public:
-    ~Constant() {
-        if (m_type->getPrimitiveType() ==
-            PType::PrimitiveTypeEnum::kStringType) {
-            free(m_value.string);
+    ~Constant() = default;
+    Constant(const TypeId p_type, const ConstantValue value)
+        : m_type(p_type), m_value(value),
+          m_constant_value_string(makeConstantValueCString(p_type, value)) {}
+
+    TypeId getType() const { return m_type; }
+    ConstantValue getValue() const { return m_value; }
+    // the string of an integer or a real, in the arena; those of booleans
+    // are static and those of strings the pool's
+    size_t getNumOfOwnedBytes() const {
+        if (m_type != TypeContext::kIntegerType &&
+            m_type != TypeContext::kRealType) {
+            return 0;
         }
+        return std::strlen(m_constant_value_string) + 1;
+    }
+    const char *getConstantValueCString() const {
+        if (m_type == TypeContext::kStringType) {
+            // the pool may still move its data while the AST is built
+            return StringLiteralPool::getInstance().getCString(m_value.string);
+        }
+        return m_constant_value_string;
     }
-    Constant(const PTypeSharedPtr &p_type, const ConstantValue value)
-        : m_type(p_type), m_value(value) {}
-
-    const PTypeSharedPtr &getTypeSharedPtr() const { return m_type; }
-    const char *getConstantValueCString() const;
 };
 
 #endif
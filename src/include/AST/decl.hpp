@@ -4,42 +4,53 @@
 #include "AST/ast.hpp"
 #include "AST/utils.hpp"
 #include "AST/variable.hpp"
+#include "util/Arena.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
-#include <vector>
-
 class DeclNode final : public AstNode {
   public:
-    using VarNodes = std::vector<std::unique_ptr<VariableNode>>;
+    using VarNodes = ArenaVector<VariableNode *>;
 
   private:
     VarNodes m_var_nodes;
 
   private:
-    void init(const std::vector<IdInfo> *const p_ids,
-              const PTypeSharedPtr &p_type,
+    void init(const ArenaVector<IdInfo> &p_ids,
+              const TypeId p_type,
               ConstantValueNode *const p_constant);
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kDecl;
+
     ~DeclNode() = default;
 
     // variable declaration
     DeclNode(const uint32_t line, const uint32_t col,
-             const std::vector<IdInfo> *const p_ids, PType *p_type)
-        : AstNode{line, col} {
-        init(p_ids, PTypeSharedPtr{p_type}, nullptr);
+             const ArenaVector<IdInfo> &p_ids, const TypeId p_type)
+        : AstNode{kKind, line, col} {
+        init(p_ids, p_type, nullptr);
     }
 
     // constant variable declaration
     DeclNode(const uint32_t line, const uint32_t col,
-             const std::vector<IdInfo> *const p_ids,
+             const ArenaVector<IdInfo> &p_ids,
              ConstantValueNode *const p_constant)
-        : AstNode{line, col} {
-        init(p_ids, p_constant->getTypeSharedPtr(), p_constant);
+        : AstNode{kKind, line, col} {
+        init(p_ids, p_constant->getType(), p_constant);
     }
 
     const VarNodes &getVariables() { return m_var_nodes; }
+    // the variables beyond the first, in the arena
+    size_t getNumOfOwnedBytes() const {
+        return m_var_nodes.getNumOfArenaBytes();
+    }
+
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        for (auto *const var_node : m_var_nodes) {
+            p_callback(*var_node);
+        }
+    }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
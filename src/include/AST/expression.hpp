@@ -1,18 +1,37 @@
 #ifndef AST_EXPRESSION_NODE_H
 #define AST_EXPRESSION_NODE_H
 
+#include "AST/PType.hpp"
 #include "AST/ast.hpp"
 
+#include <atomic>
+
 class ExpressionNode : public AstNode
 {
 public:
   ~ExpressionNode() = default;
-  ExpressionNode(const uint32_t line, const uint32_t col)
-      : AstNode{line, col} {}
+  ExpressionNode(const AstNodeKind p_kind, const uint32_t line,
+                 const uint32_t col)
+      : AstNode{p_kind, line, col} {}
+
+  // Filled in by SemanticAnalyzer once it has checked the expression:
+  // TypeContext::kNoType until then, and for an expression that is in error.
+  // VariableReferenceNode and FunctionInvocationNode also record the node
+  // that declared their name. These slots are the only part of a parsed
+  // tree that is written to. They are atomic, so analyzers may run at once
+  // on one tree; they all store the same values.
+  TypeId getResultType() const
+  {
+    return m_result_type.load(std::memory_order_relaxed);
+  }
+  void setResultType(const TypeId p_type)
+  {
+    m_result_type.store(p_type, std::memory_order_relaxed);
+  }
 
 protected:
-  // for carrying type of result of an expression
-  // TODO: for next assignment
+  // in what AstNode leaves of its last word
+  std::atomic<TypeId> m_result_type{TypeContext::kNoType};
 };
 
 #endif
@@ -9,20 +9,30 @@
 
 class ForNode final : public AstNode {
   private:
-    std::unique_ptr<DeclNode> m_loop_var_decl;
-    std::unique_ptr<AssignmentNode> m_init_stmt;
-    std::unique_ptr<ExpressionNode> m_end_condition;
-    std::unique_ptr<CompoundStatementNode> m_body;
+    DeclNode *m_loop_var_decl;
+    AssignmentNode *m_init_stmt;
+    ExpressionNode *m_end_condition;
+    CompoundStatementNode *m_body;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kFor;
+
     ~ForNode() = default;
     ForNode(const uint32_t line, const uint32_t col,
             DeclNode *p_loop_var_decl, AssignmentNode *p_init_stmt,
             ExpressionNode *p_end_condition, CompoundStatementNode *p_body)
-        : AstNode{line, col}, m_loop_var_decl(p_loop_var_decl),
+        : AstNode{kKind, line, col}, m_loop_var_decl(p_loop_var_decl),
           m_init_stmt(p_init_stmt), m_end_condition(p_end_condition),
           m_body(p_body) {}
 
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        p_callback(*m_loop_var_decl);
+        p_callback(*m_init_stmt);
+        p_callback(*m_end_condition);
+        p_callback(*m_body);
+    }
+
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
 };
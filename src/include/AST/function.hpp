@@ -2,37 +2,95 @@
 #define AST_FUNCTION_NODE_H
 
 #include "AST/CompoundStatement.hpp"
+#include "AST/PType.hpp"
 #include "AST/ast.hpp"
+#include "util/Arena.hpp"
+#include "util/StringInterner.hpp"
+#include "util/SourceBuffer.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
-#include <string>
-#include <vector>
+#include <cstdint>
+#include <cstdio>
+
+// A function body that the parser skipped (see
+// CompileOptions::lazy_function_bodies): where its tokens lie, from `begin`
+// to the matching `end`. It is parsed the first time it is visited.
+struct LazyFunctionBody {
+    // shared by the lazy bodies of one compilation
+    struct Source {
+        SourceBuffer *buffer;
+        // where a syntax error in a body goes; null once compile() has
+        // returned, the error is not reported then
+        FILE *diagnostics;
+        bool has_error;
+        // parse with the parser of ParserKind::kDescent, not bison's
+        bool by_descent;
+    };
+
+    Source *source;
+    uint32_t begin;      // the offset of `begin`
+    uint32_t end;        // the offset right after the matching `end`
+    uint32_t line;       // the line of `begin`
+    uint32_t line_start; // the offset of that line
+};
+
+// Defined in parser.y. Parses a body that the parser skipped, into the arena
+// of Arena::getInstance(). nullptr on a syntax error.
+CompoundStatementNode *parseFunctionBody(const LazyFunctionBody &p_body);
 
 class FunctionNode final : public AstNode {
   public:
-    using DeclNodes = std::vector<std::unique_ptr<DeclNode>>;
+    using DeclNodes = ArenaVector<DeclNode *>;
 
   private:
-    std::string m_name;
+    Atom m_name;
     DeclNodes m_parameters;
-    std::unique_ptr<PType> m_ret_type;
-    std::unique_ptr<CompoundStatementNode> m_body;
+    TypeId m_ret_type;
+    CompoundStatementNode *m_body;
+    // until the body is parsed
+    const LazyFunctionBody *m_lazy_body;
 
-    mutable std::string m_prototype_string;
-    mutable bool m_prototype_string_is_valid = false;
+    // in the arena of Arena::getInstance() when constructed
+    const char *m_prototype_string;
+
+    static const char *makePrototypeCString(const TypeId p_ret_type,
+                                            const DeclNodes &p_parameters);
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kFunction;
+
     ~FunctionNode() = default;
     FunctionNode(const uint32_t line, const uint32_t col,
-                 const char *const p_name, DeclNodes &p_decl_nodes,
-                 PType *const p_ret_type, CompoundStatementNode *const p_body)
-        : AstNode{line, col}, m_name(p_name),
-          m_parameters(std::move(p_decl_nodes)), m_ret_type(p_ret_type),
-          m_body(p_body) {}
-
-    const char *getNameCString() const { return m_name.c_str(); }
-    const char *getPrototypeCString() const;
+                 const Atom p_name, const DeclNodes &p_decl_nodes,
+                 const TypeId p_ret_type,
+                 CompoundStatementNode *const p_body,
+                 const LazyFunctionBody *const p_lazy_body = nullptr)
+        : AstNode{kKind, line, col}, m_name(p_name), m_parameters(p_decl_nodes),
+          m_ret_type(p_ret_type), m_body(p_body), m_lazy_body(p_lazy_body),
+          m_prototype_string(makePrototypeCString(p_ret_type, p_decl_nodes)) {}
+
+    Atom getName() const { return m_name; }
+    const char *getNameCString() const { return getAtomCString(m_name); }
+    TypeId getReturnType() const { return m_ret_type; }
+    const DeclNodes &getParameters() const { return m_parameters; }
+    // e.g. "integer (real, boolean)"
+    const char *getPrototypeCString() const { return m_prototype_string; }
+    // the parameters, the prototype string and a skipped body's
+    // LazyFunctionBody, in the arena
+    size_t getNumOfOwnedBytes() const;
+    // parses the body first if it has been skipped; null for a declaration
+    // or a body with a syntax error
+    CompoundStatementNode *getBody();
+
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        for (auto *const parameter : m_parameters) {
+            p_callback(*parameter);
+        }
+        if (getBody()) {
+            p_callback(*m_body);
+        }
+    }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
@@ -5,22 +5,31 @@
 #include "AST/expression.hpp"
 #include "AST/CompoundStatement.hpp"
 
-#include <memory>
-
 class IfNode final : public AstNode {
   private:
-    std::unique_ptr<ExpressionNode> m_condition;
-    std::unique_ptr<CompoundStatementNode> m_body;
-    std::unique_ptr<CompoundStatementNode> m_else_body;
+    ExpressionNode *m_condition;
+    CompoundStatementNode *m_body;
+    CompoundStatementNode *m_else_body;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kIf;
+
     ~IfNode() = default;
     IfNode(const uint32_t line, const uint32_t col,
            ExpressionNode *p_condition, CompoundStatementNode *p_body,
            CompoundStatementNode *p_else_body)
-        : AstNode{line, col}, m_condition(p_condition), m_body(p_body),
+        : AstNode{kKind, line, col}, m_condition(p_condition), m_body(p_body),
           m_else_body(p_else_body){}
 
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        p_callback(*m_condition);
+        p_callback(*m_body);
+        if (m_else_body) {
+            p_callback(*m_else_body);
+        }
+    }
+
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
 };
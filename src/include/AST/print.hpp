@@ -5,17 +5,22 @@
 #include "AST/expression.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
-
 class PrintNode final : public AstNode {
   private:
-    std::unique_ptr<ExpressionNode> m_target;
+    ExpressionNode *m_target;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kPrint;
+
     ~PrintNode() = default;
     PrintNode(const uint32_t line, const uint32_t col,
               ExpressionNode *p_target)
-        : AstNode{line, col}, m_target(p_target){}
+        : AstNode{kKind, line, col}, m_target(p_target){}
+
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        p_callback(*m_target);
+    }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
@@ -4,35 +4,55 @@
 #include "AST/ast.hpp"
 #include "AST/decl.hpp"
 #include "AST/function.hpp"
-
-#include <memory>
-#include <string>
-#include <vector>
+#include "util/Arena.hpp"
+#include "util/StringInterner.hpp"
 
 class ProgramNode final : public AstNode
 {
 public:
-  using DeclNodes = std::vector<std::unique_ptr<DeclNode>>;
-  using FuncNodes = std::vector<std::unique_ptr<FunctionNode>>;
+  using DeclNodes = ArenaVector<DeclNode *>;
+  using FuncNodes = ArenaVector<FunctionNode *>;
 
 private:
-  std::string m_name;
-  std::unique_ptr<PType> m_ret_type;
+  Atom m_name;
+  TypeId m_ret_type;
   DeclNodes m_decl_nodes;
   FuncNodes m_func_nodes;
-  std::unique_ptr<CompoundStatementNode> m_body;
+  CompoundStatementNode *m_body;
 
 public:
+  static constexpr AstNodeKind kKind = AstNodeKind::kProgram;
+
   ~ProgramNode() = default;
   ProgramNode(const uint32_t line, const uint32_t col,
-              const char *const p_name, PType *const p_ret_type,
-              DeclNodes &p_decl_nodes, FuncNodes &p_func_nodes,
+              const Atom p_name, const TypeId p_ret_type,
+              const DeclNodes &p_decl_nodes, const FuncNodes &p_func_nodes,
               CompoundStatementNode *const p_body)
-      : AstNode{line, col}, m_name(p_name), m_ret_type(p_ret_type),
-        m_decl_nodes(std::move(p_decl_nodes)),
-        m_func_nodes(std::move(p_func_nodes)), m_body(p_body) {}
-
-  const char *getNameCString() const { return m_name.c_str(); }
+      : AstNode{kKind, line, col}, m_name(p_name), m_ret_type(p_ret_type),
+        m_decl_nodes(p_decl_nodes), m_func_nodes(p_func_nodes),
+        m_body(p_body) {}
+
+  Atom getName() const { return m_name; }
+  const char *getNameCString() const { return getAtomCString(m_name); }
+  TypeId getReturnType() const { return m_ret_type; }
+  CompoundStatementNode *getBody() const { return m_body; }
+  // the lists of declarations and functions, in the arena
+  size_t getNumOfOwnedBytes() const
+  {
+    return m_decl_nodes.getNumOfArenaBytes() +
+           m_func_nodes.getNumOfArenaBytes();
+  }
+
+  // calls p_callback with each child, in the order of visitChildNodes()
+  template <typename Callback> void forEachChild(Callback &&p_callback) {
+    for (auto *const decl : m_decl_nodes) {
+      p_callback(*decl);
+    }
+    for (auto *const func : m_func_nodes) {
+      p_callback(*func);
+    }
+    p_callback(*m_body);
+  }
 
   void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
 
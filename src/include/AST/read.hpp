@@ -4,17 +4,22 @@
 #include "AST/ast.hpp"
 #include "AST/VariableReference.hpp"
 
-#include <memory>
-
 class ReadNode final : public AstNode {
   private:
-    std::unique_ptr<VariableReferenceNode> m_target;
+    VariableReferenceNode *m_target;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kRead;
+
     ~ReadNode() = default;
     ReadNode(const uint32_t line, const uint32_t col,
              VariableReferenceNode *p_target)
-        : AstNode{line, col}, m_target(p_target){}
+        : AstNode{kKind, line, col}, m_target(p_target){}
+
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        p_callback(*m_target);
+    }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
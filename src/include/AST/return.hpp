@@ -5,17 +5,22 @@
 #include "AST/expression.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
-
 class ReturnNode final : public AstNode {
   private:
-    std::unique_ptr<ExpressionNode> m_ret_val;
+    ExpressionNode *m_ret_val;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kReturn;
+
     ~ReturnNode() = default;
     ReturnNode(const uint32_t line, const uint32_t col,
                ExpressionNode *p_ret_val)
-        : AstNode{line, col}, m_ret_val(p_ret_val){}
+        : AstNode{kKind, line, col}, m_ret_val(p_ret_val){}
+
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        p_callback(*m_ret_val);
+    }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
@@ -3,15 +3,16 @@
 
 #include "AST/ast.hpp"
 
+#include "util/StringInterner.hpp"
+
 #include <cstdint>
-#include <string>
 
 // for carrying identifier info through IdList
 struct IdInfo {
     Location location;
-    std::string id;
+    Atom id;
 
-    IdInfo(const uint32_t line, const uint32_t col, const char * const p_id)
+    IdInfo(const uint32_t line, const uint32_t col, const Atom p_id)
         : location(line, col), id(p_id) {}
 };
 
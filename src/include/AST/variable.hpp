@@ -4,27 +4,41 @@
 #include "AST/PType.hpp"
 #include "AST/ast.hpp"
 #include "AST/ConstantValue.hpp"
+#include "util/StringInterner.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
-#include <string>
-
 class VariableNode final : public AstNode {
   private:
-    std::string m_name;
-    PTypeSharedPtr m_type;
-    std::shared_ptr<ConstantValueNode> m_constant_value_node_ptr;
+    Atom m_name;
+    // both shared by the variables of a declaration
+    TypeId m_type;
+    ConstantValueNode *m_constant_value_node_ptr;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kVariable;
+
     ~VariableNode() = default;
     VariableNode(const uint32_t line, const uint32_t col,
-                 const std::string &p_name, const PTypeSharedPtr &p_type,
-                 const std::shared_ptr<ConstantValueNode> &p_constant_value_node)
-        : AstNode{line, col}, m_name(p_name), m_type(p_type),
+                 const Atom p_name, const TypeId p_type,
+                 ConstantValueNode *const p_constant_value_node)
+        : AstNode{kKind, line, col}, m_name(p_name), m_type(p_type),
           m_constant_value_node_ptr(p_constant_value_node) {}
 
-    const char *getNameCString() const { return m_name.c_str(); }
-    const char *getTypeCString() const { return m_type->getPTypeCString(); }
+    Atom getName() const { return m_name; }
+    const char *getNameCString() const { return getAtomCString(m_name); }
+    TypeId getType() const { return m_type; }
+    const char *getTypeCString() const { return ::getTypeCString(m_type); }
+    // null unless the variable is a constant
+    ConstantValueNode *getConstantValueNode() const {
+        return m_constant_value_node_ptr;
+    }
+
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        if (m_constant_value_node_ptr) {
+            p_callback(*m_constant_value_node_ptr);
+        }
+    }
 
     void accept(AstNodeVisitor &p_visitor) override {
         p_visitor.visit(*this);
@@ -5,18 +5,24 @@
 #include "AST/expression.hpp"
 #include "AST/CompoundStatement.hpp"
 
-#include <memory>
-
 class WhileNode final : public AstNode {
   private:
-    std::unique_ptr<ExpressionNode> m_condition;
-    std::unique_ptr<CompoundStatementNode> m_body;
+    ExpressionNode *m_condition;
+    CompoundStatementNode *m_body;
 
   public:
+    static constexpr AstNodeKind kKind = AstNodeKind::kWhile;
+
     ~WhileNode() = default;
     WhileNode(const uint32_t line, const uint32_t col,
               ExpressionNode *p_condition, CompoundStatementNode *p_body)
-        : AstNode{line, col}, m_condition(p_condition), m_body(p_body){}
+        : AstNode{kKind, line, col}, m_condition(p_condition), m_body(p_body){}
+
+    // calls p_callback with each child, in the order of visitChildNodes()
+    template <typename Callback> void forEachChild(Callback &&p_callback) {
+        p_callback(*m_condition);
+        p_callback(*m_body);
+    }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
@@ -0,0 +1,53 @@
+#ifndef DRIVER_AST_CACHE_H
+#define DRIVER_AST_CACHE_H
+
+#include "util/SourceBuffer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+class ProgramNode;
+
+// A directory of the programs compiled before, so that compiling an
+// unchanged source again skips scanning and parsing (see
+// CompileOptions::ast_cache_directory). An entry is a file named after a
+// hash of the source and of the compiler, which holds the source (a hit
+// has to match it byte for byte), the listing that the lexer printed, the
+// //&D state at the end of input and the AST in the form of
+// AST/AstFile.hpp. Entries are written to a temporary file and renamed
+// into place, so that compilations running at once only see whole entries.
+class AstCache {
+  private:
+    std::string m_directory;
+
+  public:
+    ~AstCache() = default;
+    explicit AstCache(std::string p_directory)
+        : m_directory(std::move(p_directory)) {}
+
+    AstCache(const AstCache &) = delete;
+    AstCache &operator=(const AstCache &) = delete;
+
+    // On a hit, writes the listing to p_output, rebuilds the program in the
+    // arena and the tables of getInstance() and returns it, with the //&D
+    // state in p_dump_symbol_table. Returns null on a miss, also for an
+    // entry that is damaged or of another compiler, and leaves the arena
+    // and p_output untouched then.
+    ProgramNode *load(const SourceBuffer &p_source, FILE *const p_output,
+                      bool &p_dump_symbol_table) const;
+
+    // Adds the program parsed from p_source, creating the directory if
+    // need be. Returns false if the entry could not be written; the cache
+    // is only an optimization, so callers may go on.
+    bool store(const SourceBuffer &p_source, ProgramNode &p_program,
+               const std::string_view p_listing,
+               const bool p_dump_symbol_table) const;
+
+  private:
+    uint64_t getKey(const SourceBuffer &p_source) const;
+    std::string getPath(const uint64_t p_key) const;
+};
+
+#endif
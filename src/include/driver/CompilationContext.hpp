@@ -0,0 +1,115 @@
+#ifndef DRIVER_COMPILATION_CONTEXT_H
+#define DRIVER_COMPILATION_CONTEXT_H
+
+#include "AST/ast.hpp"
+#include "AST/function.hpp"
+#include "lexer/FastLexer.hpp"
+#include "lexer/FlexScanner.hpp"
+#include "lexer/ParallelLexer.hpp"
+#include "lexer/ThreadedLexer.hpp"
+#include "lexer/Token.hpp"
+#include "util/Arena.hpp"
+#include "util/SourceBuffer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+class SemanticAnalyzer;
+
+// Everything the parser and its lexer work on during one compilation, which
+// used to be globals of parser.y and scanner.l. The parser receives it
+// through %parse-param; nothing is shared between two contexts.
+struct CompilationContext {
+    SourceBuffer &source;
+    FILE *output;      // the listing, or null for none
+    FILE *diagnostics; // syntax errors, or null to not report them
+
+    // the lexer the parser pulls tokens from; exactly one is set up
+    FlexScanner flex_scanner = nullptr;
+    FlexScannerState flex_state;
+    std::unique_ptr<FastLexer> fast_lexer;
+    std::unique_ptr<ThreadedLexer> threaded_lexer;
+    std::unique_ptr<ParallelLexer> parallel_lexer;
+
+    // where the token the parser looked at last lies, for yyerror()
+    struct {
+        uint32_t line;
+        const char *line_start;
+        const char *text;
+        int length;
+    } last_token = {};
+
+    // If set, yylex() skips the bodies of function definitions, see
+    // CompileOptions::lazy_function_bodies.
+    LazyFunctionBody::Source *lazy_bodies = nullptr;
+    int previous_token = 0; // what yylex() returned last
+    std::vector<int> body_openers; // reused by skipFunctionBody()
+    // if set, what yylex() returns before the lexer's first token
+    int first_token = 0;
+
+    // If set, the parser hands the program to it piece by piece and drops
+    // each function from the arena once it is analyzed, see
+    // CompileOptions::stream_functions.
+    SemanticAnalyzer *analyzer = nullptr;
+    Arena::Mark functions_mark = {}; // where the first function starts
+
+    // a lexical or syntax error has been reported
+    bool has_error = false;
+    // the program, or the body for parseFunctionBody(); in the arena of
+    // Arena::getInstance()
+    AstNode *root = nullptr;
+
+    ~CompilationContext() {
+        if (flex_scanner != nullptr) {
+            destroyFlexScanner(flex_scanner);
+        }
+    }
+    CompilationContext(SourceBuffer &p_source, FILE *const p_output,
+                       FILE *const p_diagnostics)
+        : source(p_source), output(p_output), diagnostics(p_diagnostics) {}
+
+    CompilationContext(const CompilationContext &) = delete;
+    CompilationContext &operator=(const CompilationContext &) = delete;
+
+    // the //&D state at the end of input; the lexer must have reached it
+    bool getDumpSymbolTable() const {
+        if (fast_lexer) {
+            return fast_lexer->getDumpSymbolTable();
+        }
+        if (threaded_lexer) {
+            return threaded_lexer->getDumpSymbolTable();
+        }
+        if (parallel_lexer) {
+            return parallel_lexer->getDumpSymbolTable();
+        }
+        return flex_state.dump_symbol_table;
+    }
+};
+
+// Defined in parser.y. Parses the source with the lexer set up in
+// p_context and leaves the program in p_context.root. Returns false on a
+// lexical or syntax error, which has been reported by then.
+bool parseProgram(CompilationContext &p_context);
+// Defined in parser.y. Parses the source like parseProgram() but builds
+// nothing, see CompileOptions::syntax_only.
+bool checkSyntax(CompilationContext &p_context);
+// Defined in descent.cpp. Parses like parseProgram(), by recursive descent
+// rather than with bison's tables, see ParserKind::kDescent.
+bool parseProgramByDescent(CompilationContext &p_context);
+// Defined in parser.y, for the parser in descent.cpp: the token that yylex()
+// hands to bison, numbered as yy::parser::token, with its value or, for
+// LAZY_BODY, the skipped body.
+int nextParserToken(CompilationContext &p_context, TokenValue &p_value,
+                    YYLTYPE &p_location, LazyFunctionBody *&p_body);
+// Defined in parser.y. Reports a syntax error at the token read last, unless
+// an error has been reported already: the token, or else p_reason.
+void reportSyntaxError(CompilationContext &p_context,
+                       const char *p_reason = nullptr);
+// Defined in parser.y. Only pulls the tokens through the parser's lexer
+// interface and reports their number and the throughput on diagnostics.
+// Returns false on a lexical error.
+bool lexProgram(CompilationContext &p_context);
+
+#endif
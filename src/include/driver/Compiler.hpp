@@ -0,0 +1,156 @@
+#ifndef DRIVER_COMPILER_H
+#define DRIVER_COMPILER_H
+
+#include "AST/PType.hpp"
+#include "AST/ast.hpp"
+#include "util/Arena.hpp"
+#include "util/SourceBuffer.hpp"
+#include "util/StringInterner.hpp"
+#include "util/StringLiteralPool.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+// The compiler as a library: compile() runs the front end on one program
+// and hands back the results instead of printing them and exiting, so that
+// a long-lived process can compile many programs, also on several threads
+// at once. Each call has state of its own (scanner, parser, AST arena,
+// identifier, string literal and type tables); none is shared between calls,
+// except for the output streams that callers choose to share.
+
+enum class LexerKind { kFlex, kFast, kThreaded, kParallel };
+
+// bison's LALR(1) parser of parser.y, or the recursive-descent one of
+// descent.cpp, which builds the same AST and reports the same syntax errors,
+// except that it reports an error for blocks and expressions nested more
+// than kMaxNestingDepth deep (descent.cpp) rather than overflow the stack
+enum class ParserKind { kBison, kDescent };
+
+// What CompileOptions::dump_ast prints: the indented text of AST/AstDumper.hpp,
+// one line of JSON (AST/AstJsonDumper.hpp), or an AST file of AST/AstFile.hpp
+// (writeAstFile()). The text and the file come between the listing and the
+// symbol tables, and a reader finds the end of the file by the number of
+// words in its header. The JSON comes last, after the symbol tables, since
+// it has the type and the declaration that semantic analysis found for
+// each expression; it is the line that starts with {"kind":"program".
+enum class AstDumpFormat { kText, kJson, kBinary };
+
+struct CompileOptions {
+    LexerKind lexer = LexerKind::kFlex;
+    // for LexerKind::kParallel, an upper bound
+    size_t num_of_lexer_threads = 1;
+    // for the AST; syntax_only always uses bison's parser without actions
+    ParserKind parser = ParserKind::kBison;
+    bool dump_ast = false;
+    AstDumpFormat ast_dump_format = AstDumpFormat::kText;
+    // only scan and report the throughput, see lexProgram()
+    bool lex_only = false;
+    // only scan and parse, building the AST, and report the time the parser
+    // took on diagnostics; no pass runs
+    bool parse_only = false;
+    // only scan and parse, with a parser that has no actions: syntax errors
+    // are reported, but there is no AST and no semantic analysis
+    bool syntax_only = false;
+    // Skip the bodies of function definitions while parsing and parse each
+    // one the first time a pass visits it (FunctionNode::getBody()), which
+    // saves the time and memory for bodies that no pass visits. The AST
+    // dump and semantic analysis still visit all of them. A syntax error in
+    // a body is reported when the body is parsed, after the output of the
+    // passes before, and may be found at another token than without lazy
+    // bodies. The bodies are read from the source, which has to outlive the
+    // AST.
+    bool lazy_function_bodies = false;
+    // Analyze each function as soon as it is parsed and then drop it, so
+    // that the AST takes memory for the global declarations, the main body
+    // and one function at a time rather than for the whole program. The
+    // output is the same, but CompileResult::ast has no functions, and
+    // dump_ast has no effect. The symbol tables wait in a temporary file
+    // until the end of input, and the semantic errors in memory; neither is
+    // printed after a syntax error. With lazy_function_bodies, a syntax
+    // error in a body is reported before those in the rest of the program.
+    // Not with LexerKind::kThreaded or kParallel: the analysis reads names,
+    // and a lazy body interns them, while the lexer threads still intern
+    // those of the rest of the program.
+    bool stream_functions = false;
+    // Flatten the AST into a FlatAst once it has been parsed, for dump_ast
+    // to dump that instead, as text; with parse_only, report the memory of
+    // both on diagnostics. Semantic analysis still walks the AST.
+    bool flat_ast = false;
+    // With parse_only, walk the AST this many times with a visitor that
+    // counts the nodes, once dispatched through virtual calls
+    // (AstNodeVisitor), once statically (AstStaticVisitor) and once with a
+    // stack of its own (AstWalker), and report the walks a second of each
+    // on diagnostics.
+    size_t num_of_traversals = 0;
+    // Once the AST has been parsed, report on diagnostics the nodes of each
+    // class with the memory they take, and the bytes per line of the source
+    // (see AST/AstStats.hpp). Lazy function bodies are parsed first. No
+    // effect with lex_only, syntax_only or stream_functions.
+    bool ast_stats = false;
+    // If set, a directory of ASTs keyed by the source and the compiler (see
+    // driver/AstCache.hpp): a source compiled before is not scanned and
+    // parsed again, its AST and listing are read from there. Otherwise the
+    // listing is held back until the parse ends, and the program is added
+    // to the cache if it parsed. No effect with lex_only, syntax_only,
+    // parse_only, lazy_function_bodies or stream_functions.
+    const char *ast_cache_directory = nullptr;
+    // Before the passes, run the AST dump and semantic analysis on this many
+    // threads at once, over the same AST, each into a stream of its own, and
+    // fail with a message on diagnostics if any of them prints other than a
+    // run on the calling thread. A test that the passes only read the AST
+    // (see AST/ast.hpp), for a build with -fsanitize=thread in particular;
+    // no effect with parse_only or stream_functions.
+    size_t num_of_concurrent_passes = 0;
+
+    // Where the listing, the AST dump and the symbol tables go, and where
+    // syntax and semantic errors go. If null, they are collected into
+    // CompileResult::output and CompileResult::diagnostics instead.
+    FILE *output = nullptr;
+    FILE *diagnostics = nullptr;
+};
+
+struct CompileResult {
+    // false if a lexical or syntax error stopped the compilation; there is
+    // no AST then, nor with CompileOptions::syntax_only. Also false if a
+    // lazy function body had a syntax error, the AST has no body for it.
+    bool is_successful = false;
+    size_t num_of_semantic_errors = 0;
+
+    // in the arena, which goes with the result
+    AstNode *ast = nullptr;
+    std::unique_ptr<Arena> arena;
+    // The tables that the atoms, string literal ids and TypeIds in the AST
+    // refer to. Put them in a StringInterner::Scope, a
+    // StringLiteralPool::Scope and a TypeContext::Scope to read names,
+    // literals and types through the AST, on as many threads as need to;
+    // the passes do not add to them.
+    std::unique_ptr<StringInterner> atoms;
+    std::unique_ptr<StringLiteralPool> literals;
+    std::unique_ptr<TypeContext> types;
+
+    // the copy that compile(const char *, ...) made of the source
+    std::unique_ptr<SourceBuffer> source;
+
+    // what was not written to CompileOptions::output / diagnostics
+    std::string output;
+    std::string diagnostics;
+};
+
+// Why the options cannot be compiled together, or null if they can.
+// compile() throws std::invalid_argument with the reason then.
+const char *getOptionsError(const CompileOptions &p_options);
+
+// Compiles a source held in memory; the buffer is copied.
+CompileResult compile(const char *const p_source, const size_t p_size,
+                      const CompileOptions &p_options);
+// Compiles a source the caller has loaded already, scanning it in place.
+CompileResult compile(SourceBuffer &p_source, const CompileOptions &p_options);
+
+// Defined in parser.y. Scans the source with both the flex scanner and
+// FastLexer and writes the first difference between the token streams or
+// listings to p_output (`--lexer=diff`). Returns whether they are identical.
+bool diffLexers(SourceBuffer &p_source, FILE *const p_output);
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef LEXER_FAST_LEXER_H
+#define LEXER_FAST_LEXER_H
+
+#include "lexer/Token.hpp"
+#include "util/StringInterner.hpp"
+#include "util/StringLiteralPool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Hand-written scanner that accepts exactly the language of scanner.l and
+// yields the same tokens at the same locations. scanner.l stays the
+// reference; `--lexer=diff` compares the two.
+//
+// Runs of blanks, identifier and digit characters and the bodies of comments
+// and string literals are classified 16 bytes at a time with SSE2 where
+// available.
+//
+// The output that scanner.l prints while matching (the source listing and
+// the token listing, both switchable by pseudocomments) is appended to a
+// listing buffer instead, so that the caller decides when it is written.
+class FastLexer {
+  public:
+    struct PseudocommentStates {
+        bool list_source = true;       // //&S
+        bool list_token = true;        // //&T
+        bool dump_symbol_table = true; // //&D
+    };
+
+    // where a part of the source that can be scanned on its own starts
+    struct ChunkStart {
+        uint32_t offset; // the start of a line outside any C-style comment
+        uint32_t line;
+        PseudocommentStates states;
+    };
+
+  private:
+    const char *m_source;
+    const char *m_cursor;
+    const char *m_end;
+    const char *m_line_start;
+    uint32_t m_line;
+    bool m_in_comment = false;
+    PseudocommentStates m_states;
+
+    // where identifiers are interned and string literals pooled
+    StringInterner *m_atoms;
+    StringLiteralPool *m_literals;
+
+    std::string m_listing;
+    std::string m_scratch; // NUL-terminated copies and decoded literals
+
+  public:
+    ~FastLexer() = default;
+    FastLexer(const char *const p_source, const size_t p_size)
+        : m_source(p_source), m_cursor(p_source), m_end(p_source + p_size),
+          m_line_start(p_source), m_line(1),
+          m_atoms(&StringInterner::getInstance()),
+          m_literals(&StringLiteralPool::getInstance()) {}
+    // scans [p_start.offset, p_end) of the source only; token offsets are
+    // still from the beginning of the source
+    FastLexer(const char *const p_source, const size_t p_end,
+              const ChunkStart &p_start, StringInterner &p_atoms,
+              StringLiteralPool &p_literals)
+        : m_source(p_source), m_cursor(p_source + p_start.offset),
+          m_end(p_source + p_end), m_line_start(m_cursor),
+          m_line(p_start.line), m_states(p_start.states), m_atoms(&p_atoms),
+          m_literals(&p_literals) {}
+    // scans [p_begin, p_end) of the source, which lies outside any C-style
+    // comment, on line p_line that starts at p_line_start; the listing is
+    // off until a pseudocomment turns it on
+    FastLexer(const char *const p_source, const size_t p_begin,
+              const size_t p_end, const uint32_t p_line,
+              const size_t p_line_start)
+        : m_source(p_source), m_cursor(p_source + p_begin),
+          m_end(p_source + p_end), m_line_start(p_source + p_line_start),
+          m_line(p_line), m_states{false, false, true},
+          m_atoms(&StringInterner::getInstance()),
+          m_literals(&StringLiteralPool::getInstance()) {}
+
+    // Scans the next token. Once the input is exhausted, every call yields
+    // TokenKind::kEndOfInput. A kBadCharacter token is the single byte that
+    // no rule accepts; the caller reports it.
+    void next(Token &p_token);
+
+    const char *getSource() const { return m_source; }
+    std::string &getListing() { return m_listing; }
+    bool getDumpSymbolTable() const { return m_states.dump_symbol_table; }
+    // the line the scanner is on, which may be past the last token's
+    uint32_t getLine() const { return m_line; }
+
+    // A cheap pass over the source that picks where to split it into at
+    // most p_num_of_chunks parts of similar size, which can then be
+    // scanned concurrently. The first part starts at offset 0.
+    static std::vector<ChunkStart> findChunkStarts(const char *const p_source,
+                                                   const size_t p_size,
+                                                   const size_t p_num_of_chunks);
+
+  private:
+    void scanNewline();
+    void scanLineComment();
+    void scanBlockComment();
+    void scanIdentifierOrKeyword(Token &p_token);
+    void scanNumber(Token &p_token);
+    bool scanString(Token &p_token);
+
+    void listToken(const TokenKind p_kind);
+    void listLiteral(const char *const p_name, const char *const p_text,
+                     const size_t p_length);
+    const char *copyToScratch(const char *const p_text, const size_t p_length);
+};
+
+#endif
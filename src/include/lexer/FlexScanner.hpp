@@ -0,0 +1,41 @@
+#ifndef LEXER_FLEX_SCANNER_H
+#define LEXER_FLEX_SCANNER_H
+
+#include "util/SourceBuffer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// What a scanner.l scanner keeps between tokens; flex reaches it through
+// yyextra, so that any number of scanners can run at once.
+struct FlexScannerState {
+    uint32_t line_num = 1;
+    uint32_t col_num = 1;
+    // the line being scanned is a view into the source buffer, it ends right
+    // before yytext (or at yytext + yyleng for the token just returned)
+    const char *current_line_start = nullptr;
+
+    bool list_source = true;       // //&S
+    bool list_token = true;        // //&T
+    bool dump_symbol_table = true; // //&D
+
+    // decoding buffer for string literals that contain ""
+    std::string string_literal;
+};
+
+// A reentrant scanner.l scanner (yyscan_t). Its tokens come from
+// scanToken(), which parser.y declares since it needs the parser's types.
+using FlexScanner = void *;
+
+// Scans p_source in place and writes the listing to p_listing; p_state must
+// outlive the scanner. nullptr on allocation failure.
+FlexScanner createFlexScanner(SourceBuffer &p_source, FlexScannerState &p_state,
+                              FILE *const p_listing);
+void destroyFlexScanner(FlexScanner p_scanner);
+
+// the text of the token matched last (yytext, yyleng)
+const char *getFlexScannerText(FlexScanner p_scanner);
+int getFlexScannerLength(FlexScanner p_scanner);
+
+#endif
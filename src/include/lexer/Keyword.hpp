@@ -0,0 +1,21 @@
+#ifndef LEXER_KEYWORD_H
+#define LEXER_KEYWORD_H
+
+#include "lexer/Token.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+// A word that [a-zA-Z][a-zA-Z0-9]* matches but that is not an identifier:
+// a word operator or a reserved word.
+struct Keyword {
+    std::string_view spelling;
+    TokenKind kind;
+    const char *listing_name; // what the token listing shows
+};
+
+// Classifies a word with a single probe of a perfect hash table; nullptr if
+// the word is an identifier.
+const Keyword *lookUpKeyword(const char *const p_word, const size_t p_length);
+
+#endif
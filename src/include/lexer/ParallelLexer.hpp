@@ -0,0 +1,98 @@
+#ifndef LEXER_PARALLEL_LEXER_H
+#define LEXER_PARALLEL_LEXER_H
+
+#include "lexer/FastLexer.hpp"
+#include "lexer/Token.hpp"
+#include "util/StringInterner.hpp"
+#include "util/StringLiteralPool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Splits the source into chunks at the places FastLexer::findChunkStarts()
+// picks and scans them concurrently, one FastLexer per chunk.
+//
+// Each chunk interns identifiers and pools string literals into tables of
+// its own. Once a chunk is scanned, its tables are merged into the ones that
+// were current on the constructing thread, in chunk order (so that the ids do not depend on timing) and its
+// tokens are rewritten to the global ids. The consumer sees the chunks'
+// tokens and listings stitched back together, as if a single FastLexer had
+// scanned the whole source; it can start on the first chunk while the
+// others are still being scanned.
+class ParallelLexer {
+  private:
+    // sources smaller than this per thread are not worth splitting
+    static constexpr size_t kMinChunkSize = 1 << 20;
+
+    struct Chunk {
+        FastLexer::ChunkStart start;
+        size_t end;
+
+        std::vector<Token> tokens; // ends with kEndOfInput or kBadCharacter
+        // the listing before tokens[i] ends at listing_ends[i]
+        std::vector<uint32_t> listing_ends;
+        std::string listing;
+        bool dump_symbol_table;
+
+        StringInterner atoms;
+        StringLiteralPool literals;
+
+        bool is_ready = false; // guarded by m_mutex
+    };
+
+    const char *m_source;
+    // where the chunks' tables are merged into
+    StringInterner *m_atoms;
+    StringLiteralPool *m_literals;
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    size_t m_num_of_merged_chunks = 0; // guarded by m_mutex
+    std::atomic<bool> m_is_stopping{false};
+
+    // consumer side
+    size_t m_chunk_index = 0;
+    size_t m_token_index = 0;
+    bool m_is_at_end = false;
+    std::string_view m_listing;
+    std::string m_joined_listing; // a listing that spans two chunks
+
+  public:
+    ~ParallelLexer();
+    // p_num_of_threads is an upper bound; small sources use fewer
+    ParallelLexer(const char *const p_source, const size_t p_size,
+                  const size_t p_num_of_threads);
+
+    ParallelLexer(const ParallelLexer &) = delete;
+    ParallelLexer &operator=(const ParallelLexer &) = delete;
+
+    // Same contract as FastLexer::next(), except that nothing follows a
+    // kBadCharacter token. Waits for the chunk being read to be scanned.
+    void next(Token &p_token);
+    // what the lexer listed before the token last returned by next()
+    std::string_view getListing() const { return m_listing; }
+
+    const char *getSource() const { return m_source; }
+    size_t getNumOfChunks() const { return m_chunks.size(); }
+    // only valid after the end of input has been received
+    bool getDumpSymbolTable() const {
+        return m_chunks.back()->dump_symbol_table;
+    }
+
+  private:
+    void scanChunk(const size_t p_index);
+    void mergeChunk(Chunk &p_chunk);
+    Chunk &waitForChunk(const size_t p_index);
+};
+
+#endif
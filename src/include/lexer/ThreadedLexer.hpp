@@ -0,0 +1,72 @@
+#ifndef LEXER_THREADED_LEXER_H
+#define LEXER_THREADED_LEXER_H
+
+#include "lexer/FastLexer.hpp"
+#include "lexer/Token.hpp"
+#include "util/SpscRing.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Runs a FastLexer on its own thread, ahead of the parser.
+//
+// Tokens travel to the consumer through an SpscRing in batches, together
+// with the listing that FastLexer produced on the way to each of them, so
+// that the consumer can write the listing at exactly the point the
+// synchronous lexer would have.
+//
+// While the lexer thread runs, it is the only one that interns identifiers
+// and pools string literals; the consumer must not look them up before the
+// end of input has been received.
+class ThreadedLexer {
+  private:
+    static constexpr size_t kBatchSize = 256;
+    static constexpr size_t kNumOfBatches = 64;
+
+    struct Batch {
+        std::vector<Token> tokens;
+        // the listing before tokens[i] ends at listing_ends[i]
+        std::vector<uint32_t> listing_ends;
+        std::string listing;
+    };
+
+    FastLexer m_lexer;
+    SpscRing<Batch> m_batches;
+    std::atomic<bool> m_is_stopping{false};
+    std::thread m_thread;
+
+    // consumer side
+    Batch *m_batch = nullptr;
+    size_t m_index = 0;
+    bool m_is_at_end = false;
+    std::string_view m_listing;
+
+  public:
+    ~ThreadedLexer();
+    ThreadedLexer(const char *const p_source, const size_t p_size);
+
+    ThreadedLexer(const ThreadedLexer &) = delete;
+    ThreadedLexer &operator=(const ThreadedLexer &) = delete;
+
+    // Same contract as FastLexer::next(), except that nothing follows a
+    // kBadCharacter token. Waits for the lexer thread if it has not got
+    // that far yet.
+    void next(Token &p_token);
+    // what the lexer listed before the token last returned by next()
+    std::string_view getListing() const { return m_listing; }
+
+    const char *getSource() const { return m_lexer.getSource(); }
+    // only valid after the end of input has been received
+    bool getDumpSymbolTable();
+
+  private:
+    void run();
+    void join();
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef LEXER_TOKEN_H
+#define LEXER_TOKEN_H
+
+#include "util/StringInterner.hpp"
+#include "util/StringLiteralPool.hpp"
+
+#include <cstdint>
+
+// identifiers longer than this are truncated (as in scanner.l)
+constexpr uint32_t kMaxIdentifierLength = 32;
+
+// Follow the order in scanner.l
+enum class TokenKind : uint8_t {
+    kEndOfInput,
+
+    // Delimiter
+    kComma,
+    kSemicolon,
+    kColon,
+    kLeftParenthesis,
+    kRightParenthesis,
+    kLeftBracket,
+    kRightBracket,
+
+    // Operator
+    kPlus,
+    kMinus,
+    kMultiply,
+    kDivide,
+    kMod,
+    kAssign,
+    kLess,
+    kLessOrEqual,
+    kNotEqual,
+    kGreaterOrEqual,
+    kGreater,
+    kEqual,
+    kAnd,
+    kOr,
+    kNot,
+
+    // Reserved Word
+    kVar,
+    kArray,
+    kOf,
+    kBoolean,
+    kInteger,
+    kReal,
+    kString,
+    kTrue,
+    kFalse,
+    kDef,
+    kReturn,
+    kBegin,
+    kEnd,
+    kWhile,
+    kDo,
+    kIf,
+    kThen,
+    kElse,
+    kFor,
+    kTo,
+    kPrint,
+    kRead,
+
+    // Identifier
+    kIdentifier,
+
+    // Literal
+    kIntLiteral,
+    kRealLiteral,
+    kStringLiteral,
+
+    // a character that no rule accepts
+    kBadCharacter,
+};
+
+constexpr size_t kNumOfTokenKinds =
+    static_cast<size_t>(TokenKind::kBadCharacter) + 1;
+
+// same members as the basic semantic values of the parser
+union TokenValue {
+    Atom identifier;
+    uint32_t integer;
+    double real;
+    StringLiteralId string;
+    bool boolean;
+};
+
+// A decoded token. The spelling is [offset, offset + length) of the source
+// buffer; col is counted in bytes from 1, so the line starts at
+// offset - (col - 1).
+struct Token {
+    TokenKind kind;
+    TokenValue value;
+    uint32_t line;
+    uint32_t col;
+    uint32_t offset;
+    uint32_t length;
+};
+
+// Where a token lies, as the flex scanner reports it and both parsers
+// (parser.y and the syntax-only one made from it) keep it; flex and bison
+// know it by this name.
+struct YYLTYPE {
+    uint32_t first_line = 1;
+    uint32_t first_column = 1;
+    uint32_t last_line = 1;
+    uint32_t last_column = 1;
+};
+
+#endif
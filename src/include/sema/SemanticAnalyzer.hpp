@@ -1,10 +1,14 @@
 #ifndef SEMA_SEMANTIC_ANALYZER_H
 #define SEMA_SEMANTIC_ANALYZER_H
 
-#include "visitor/AstNodeVisitor.hpp"
+#include "visitor/AstWalker.hpp"
 
 #include "AST/PType.hpp"
+#include "AST/ast.hpp"
+#include "util/LineIndex.hpp"
+#include "util/StringInterner.hpp"
 
+#include <cstdio>
 #include <vector>
 #include <stack>
 #include <string>
@@ -28,13 +32,19 @@ enum PNameType
 
 struct SymbolEntry
 {
-  std::string name;
+  Atom name = StringInterner::kEmptyAtom;
   PNameType kind;
   uint16_t level;
-  std::string type;
+  TypeId type = TypeContext::kNoType;
+  // of a function
+  std::vector<TypeId> parameter_types;
   std::string attr_str;
   uint32_t line;
   uint32_t column;
+  // the VariableNode or FunctionNode that declared the symbol
+  const AstNode *declaration = nullptr;
+
+  const char *getNameCString() const { return getAtomCString(name); }
 };
 
 class SymbolTable
@@ -71,18 +81,18 @@ public:
     return false;
   }
 
-  void dumpDemarcation(const char chr)
+  void dumpDemarcation(FILE *output, const char chr)
   {
     for (size_t i = 0; i < 110; ++i)
     {
-      printf("%c", chr);
+      fputc(chr, output);
     }
-    puts("");
+    fputc('\n', output);
   }
 
-  void dumpSymbolEntry(const SymbolEntry dump_entry)
+  void dumpSymbolEntry(FILE *output, const SymbolEntry dump_entry)
   {
-    printf("%-33s", dump_entry.name.c_str());
+    fprintf(output, "%-33s", dump_entry.getNameCString());
 
     std::string kind_str = "";
     switch (dump_entry.kind)
@@ -107,7 +117,7 @@ public:
       break;
     default:;
     }
-    printf("%-11s", kind_str.c_str());
+    fprintf(output, "%-11s", kind_str.c_str());
 
     std::string scope_str = "";
     if (dump_entry.level == 0)
@@ -118,40 +128,43 @@ public:
     {
       scope_str = "(local)";
     }
-    printf("%d%-10s", dump_entry.level, scope_str.c_str());
+    fprintf(output, "%d%-10s", dump_entry.level, scope_str.c_str());
 
-    printf("%-17s", dump_entry.type.c_str());
+    fprintf(output, "%-17s", getTypeCString(dump_entry.type));
 
     if (dump_entry.kind != ConstantType && dump_entry.attr_str == "error")
     {
       std::string empty_str = "";
-      printf("%-11s", empty_str.c_str());
+      fprintf(output, "%-11s", empty_str.c_str());
     }
     else
     {
-      printf("%-11s", dump_entry.attr_str.c_str());
+      fprintf(output, "%-11s", dump_entry.attr_str.c_str());
     }
 
-    puts("");
+    fputc('\n', output);
   }
 
-  void dumpSymbolTable(void)
+  void dumpSymbolTable(FILE *output)
   {
-    dumpDemarcation('=');
-    printf("%-33s%-11s%-11s%-17s%-11s\n", "Name", "Kind", "Level", "Type", "Attribute");
+    dumpDemarcation(output, '=');
+    fprintf(output, "%-33s%-11s%-11s%-17s%-11s\n", "Name", "Kind", "Level", "Type", "Attribute");
 
-    dumpDemarcation('-');
+    dumpDemarcation(output, '-');
 
     for (const auto &entry : entries)
     {
-      dumpSymbolEntry(entry);
+      dumpSymbolEntry(output, entry);
     }
 
-    dumpDemarcation('-');
+    dumpDemarcation(output, '-');
   }
 };
 
-class SemanticAnalyzer final : public AstNodeVisitor
+// Runs on AstWalker::walk(): the nodes that open a scope set it up in
+// preVisit(), and each node is checked in postVisit(), once the entries of
+// its children are on child_entries_stack.
+class SemanticAnalyzer final : public AstWalker<SemanticAnalyzer>
 {
 private:
   // TODO: something like symbol manager (manage symbol tables)
@@ -161,7 +174,11 @@ private:
   std::vector<SymbolEntry> parent_entries_stack;
   std::stack<SymbolEntry> child_entries_stack;
   bool dumpSymbolTable = true;
-  std::vector<std::string> source_code;
+  bool functionsRetained = true;
+  LineIndex *source_lines = nullptr;
+  // symbol tables and the closing message go to output, errors to diagnostics
+  FILE *output = stdout;
+  FILE *diagnostics = stderr;
   std::vector<std::string> error_messages;
 
   void pushScope()
@@ -173,7 +190,7 @@ private:
   {
     if (dumpSymbolTable)
     {
-      tables.back().dumpSymbolTable();
+      tables.back().dumpSymbolTable(output);
     }
     tables.pop_back();
   }
@@ -185,7 +202,9 @@ private:
       if (entry.name == insert_entry.name)
       {
         std::string error_message = "";
-        error_message += "symbol '" + insert_entry.name + "' is redeclared";
+        error_message += "symbol '";
+        error_message += insert_entry.getNameCString();
+        error_message += "' is redeclared";
         listErrorMessage(insert_entry.line, insert_entry.column, error_message);
         return false;
       }
@@ -198,7 +217,9 @@ private:
     else
     {
       std::string error_message = "";
-      error_message += "symbol '" + insert_entry.name + "' is redeclared";
+      error_message += "symbol '";
+      error_message += insert_entry.getNameCString();
+      error_message += "' is redeclared";
       listErrorMessage(insert_entry.line, insert_entry.column, error_message);
       return false;
     }
@@ -215,7 +236,9 @@ private:
     }
 
     std::string error_message = "";
-    error_message += "use of undeclared symbol '" + get_entry.name + "'";
+    error_message += "use of undeclared symbol '";
+    error_message += get_entry.getNameCString();
+    error_message += "'";
     listErrorMessage(get_entry.line, get_entry.column, error_message);
 
     return false;
@@ -226,26 +249,40 @@ private:
     return tables.size() - 1;
   }
 
+  // pushes the entry of an expression onto child_entries_stack, and
+  // records its type, and the declaration of a name, on the node for later
+  // passes
+  void pushExpressionEntry(ExpressionNode &p_expression, const SymbolEntry &p_entry);
+  void pushExpressionEntry(VariableReferenceNode &p_variable_ref, const SymbolEntry &p_entry);
+  void pushExpressionEntry(FunctionInvocationNode &p_func_invocation, const SymbolEntry &p_entry);
+
 public:
   void setSymbolTableDump(bool D)
   {
     dumpSymbolTable = D;
   }
 
-  void setSourceCode(char *code[200])
+  // false for a caller that frees each function once it is analyzed; calls
+  // then record no FunctionNode
+  void setFunctionsRetained(bool retained)
   {
-    source_code.resize(200);
-    for (int i = 0; i < 200; i++)
-    {
-      if (code[i])
-      {
-        source_code[i] = code[i];
-      }
-      else
-      {
-        source_code[i] = "";
-      }
-    }
+    functionsRetained = retained;
+  }
+
+  void setSourceLines(LineIndex *lines)
+  {
+    source_lines = lines;
+  }
+
+  void setOutput(FILE *out, FILE *diag)
+  {
+    output = out;
+    diagnostics = diag;
+  }
+
+  size_t getNumOfErrors() const
+  {
+    return error_messages.size();
   }
 
   void listErrorMessage(uint32_t line, uint32_t column, std::string message)
@@ -254,7 +291,9 @@ public:
 
     error_message += "<Error> Found in line " + std::to_string(line) + ", column " + std::to_string(column) + ": " + message + "\n";
 
-    error_message += "    " + source_code[line] + "\n";
+    error_message += "    ";
+    error_message += source_lines->getLine(line);
+    error_message += "\n";
 
     error_message += "   ";
     for (uint32_t i = 0; i < column; i++)
@@ -271,16 +310,16 @@ public:
     if (error_messages.empty())
     {
       // TODO: do not print this if there's any semantic error
-      printf("\n"
-             "|---------------------------------------------------|\n"
-             "|  There is no syntactic error and semantic error!  |\n"
-             "|---------------------------------------------------|\n");
+      fprintf(output, "\n"
+                      "|---------------------------------------------------|\n"
+                      "|  There is no syntactic error and semantic error!  |\n"
+                      "|---------------------------------------------------|\n");
     }
     else
     {
       for (const auto &error_message : error_messages)
       {
-        std::cerr << error_message;
+        fputs(error_message.c_str(), diagnostics);
       }
     }
   }
@@ -289,23 +328,35 @@ public:
   ~SemanticAnalyzer() = default;
   SemanticAnalyzer() = default;
 
-  void visit(ProgramNode &p_program) override;
-  void visit(DeclNode &p_decl) override;
-  void visit(VariableNode &p_variable) override;
-  void visit(ConstantValueNode &p_constant_value) override;
-  void visit(FunctionNode &p_function) override;
-  void visit(CompoundStatementNode &p_compound_statement) override;
-  void visit(PrintNode &p_print) override;
-  void visit(BinaryOperatorNode &p_bin_op) override;
-  void visit(UnaryOperatorNode &p_un_op) override;
-  void visit(FunctionInvocationNode &p_func_invocation) override;
-  void visit(VariableReferenceNode &p_variable_ref) override;
-  void visit(AssignmentNode &p_assignment) override;
-  void visit(ReadNode &p_read) override;
-  void visit(IfNode &p_if) override;
-  void visit(WhileNode &p_while) override;
-  void visit(ForNode &p_for) override;
-  void visit(ReturnNode &p_return) override;
+  // walk(ProgramNode &) in pieces, for a program that is analyzed while it
+  // is parsed: beginProgram(), then the declarations, functions and body
+  // are walked, then endProgram() and printErrorMessages()
+  void beginProgram(const Atom p_name, const Location &p_location);
+  void endProgram();
+
+  using AstWalker<SemanticAnalyzer>::preVisit;
+  void preVisit(ProgramNode &p_program);
+  void preVisit(FunctionNode &p_function);
+  void preVisit(CompoundStatementNode &p_compound_statement);
+  void preVisit(ForNode &p_for);
+
+  using AstWalker<SemanticAnalyzer>::postVisit;
+  void postVisit(ProgramNode &p_program);
+  void postVisit(VariableNode &p_variable);
+  void postVisit(ConstantValueNode &p_constant_value);
+  void postVisit(FunctionNode &p_function);
+  void postVisit(CompoundStatementNode &p_compound_statement);
+  void postVisit(PrintNode &p_print);
+  void postVisit(BinaryOperatorNode &p_bin_op);
+  void postVisit(UnaryOperatorNode &p_un_op);
+  void postVisit(FunctionInvocationNode &p_func_invocation);
+  void postVisit(VariableReferenceNode &p_variable_ref);
+  void postVisit(AssignmentNode &p_assignment);
+  void postVisit(ReadNode &p_read);
+  void postVisit(IfNode &p_if);
+  void postVisit(WhileNode &p_while);
+  void postVisit(ForNode &p_for);
+  void postVisit(ReturnNode &p_return);
 };
 
 #endif
@@ -0,0 +1,199 @@
+#ifndef UTIL_ARENA_H
+#define UTIL_ARENA_H
+
+#include "util/ScopedInstance.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bump allocator for what lives as long as one compilation: the AST and the
+// lists the parser builds it from. Allocating moves a cursor through
+// fixed-size blocks; nothing is freed on its own, the blocks are released
+// all at once with the arena, or those since a Mark with rewind().
+// getInstance() is the arena of the running compilation (see
+// util/ScopedInstance.hpp).
+//
+// Objects in an arena are never destroyed, so create() only takes types
+// that are trivially destructible: they may point into the arena but must
+// not own memory elsewhere.
+class Arena : public ScopedInstance<Arena> {
+  private:
+    static constexpr size_t kBlockSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    uintptr_t m_cursor = 0;
+    uintptr_t m_end = 0;
+
+    size_t m_num_of_allocations = 0;
+    size_t m_num_of_bytes = 0; // as requested, without padding
+
+  public:
+    ~Arena() = default;
+    // a private arena; most code uses the one of getInstance()
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // where the cursor is, for rewind()
+    struct Mark {
+        size_t num_of_blocks;
+        uintptr_t cursor;
+        uintptr_t end;
+    };
+    Mark getMark() const { return {m_blocks.size(), m_cursor, m_end}; }
+    // Releases what was allocated after p_mark was taken, which nothing may
+    // point to anymore. The statistics still count it.
+    void rewind(const Mark &p_mark);
+
+    // p_alignment must be a power of 2
+    void *allocate(const size_t p_size, const size_t p_alignment) {
+        ++m_num_of_allocations;
+        m_num_of_bytes += p_size;
+
+        const uintptr_t start =
+            (m_cursor + p_alignment - 1) & ~(uintptr_t{p_alignment} - 1);
+        if (start > m_end || p_size > m_end - start) {
+            return allocateInNewBlock(p_size, p_alignment);
+        }
+        m_cursor = start + p_size;
+        return reinterpret_cast<void *>(start);
+    }
+
+    template <typename T, typename... Args> T *create(Args &&...p_args) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "objects in an Arena are never destroyed");
+        return new (allocate(sizeof(T), alignof(T)))
+            T(std::forward<Args>(p_args)...);
+    }
+
+    // uninitialized room for p_count objects
+    template <typename T> T *allocateArray(const size_t p_count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "objects in an Arena are never destroyed");
+        return static_cast<T *>(allocate(sizeof(T) * p_count, alignof(T)));
+    }
+
+    // a NUL-terminated copy
+    const char *copyString(const std::string_view p_string) {
+        char *const copy = allocateArray<char>(p_string.size() + 1);
+        std::memcpy(copy, p_string.data(), p_string.size());
+        copy[p_string.size()] = '\0';
+        return copy;
+    }
+
+    size_t getNumOfAllocations() const { return m_num_of_allocations; }
+    size_t getNumOfBytes() const { return m_num_of_bytes; }
+    size_t getNumOfBlocks() const { return m_blocks.size(); }
+
+  private:
+    void *allocateInNewBlock(const size_t p_size, const size_t p_alignment);
+};
+
+// Creates an object in the arena of getInstance().
+template <typename T, typename... Args> T *newInArena(Args &&...p_args) {
+    return Arena::getInstance().create<T>(std::forward<Args>(p_args)...);
+}
+
+// A list in the arena of getInstance(), for the children of AST nodes and
+// the lists the parser collects them in. A list is built in one
+// ArenaVector and then handed on by value. Growing leaves the old elements
+// in the arena, which at most doubles what a list costs.
+//
+// As many elements as fit in the room of the pointer to them (one child
+// pointer, one array dimension) are kept in the ArenaVector itself, and
+// only longer lists take memory in the arena. Copies share the elements
+// once those are in the arena and copy them while they are inline. In the
+// test cases and in the programs test/bench.py generates, the declarations
+// of a block, the parameters of a function, the arguments of a call and
+// the indices of a reference have no or one element for between half and
+// nine in ten of the lists, a declaration has one variable for two in
+// three or more, and a block has one statement for a third to nearly half
+// of the blocks. An inline room for two would take 8 more bytes in every
+// list to spare the arena for the few lists of two.
+template <typename T> class ArenaVector {
+    static_assert(std::is_trivially_copyable<T>::value &&
+                      std::is_trivially_destructible<T>::value,
+                  "elements are moved with memcpy and never destroyed");
+
+  public:
+    static constexpr uint32_t kInlineCapacity = sizeof(T *) / sizeof(T);
+
+  private:
+    union {
+        T *m_data = nullptr;
+        alignas(T) unsigned char m_inline[sizeof(T *)];
+    };
+    uint32_t m_size = 0;
+    // kInlineCapacity while the elements are inline
+    uint32_t m_capacity = kInlineCapacity;
+
+  public:
+    using value_type = T;
+    using const_iterator = const T *;
+
+    void push_back(const T &p_value) {
+        if (m_size == m_capacity) {
+            grow();
+        }
+        new (data() + m_size) T(p_value);
+        ++m_size;
+    }
+    template <typename... Args> void emplace_back(Args &&...p_args) {
+        push_back(T(std::forward<Args>(p_args)...));
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const T *begin() const { return data(); }
+    const T *end() const { return data() + m_size; }
+    const T &operator[](const size_t p_index) const {
+        return data()[p_index];
+    }
+    const T &back() const { return data()[m_size - 1]; }
+
+    // what the elements take in the arena, with the arrays that growing
+    // left behind; none while they are inline
+    size_t getNumOfArenaBytes() const {
+        if (isInline()) {
+            return 0;
+        }
+        // the capacities went from the first array's up to m_capacity,
+        // doubling, and add up to twice m_capacity less the first
+        return sizeof(T) * (2 * size_t{m_capacity} - kFirstCapacity);
+    }
+
+  private:
+    static constexpr uint32_t kFirstCapacity =
+        std::max(uint32_t{4}, 2 * kInlineCapacity);
+
+    bool isInline() const { return m_capacity == kInlineCapacity; }
+    T *data() {
+        return isInline() ? reinterpret_cast<T *>(m_inline) : m_data;
+    }
+    const T *data() const {
+        return isInline() ? reinterpret_cast<const T *>(m_inline) : m_data;
+    }
+
+    void grow() {
+        const uint32_t capacity =
+            isInline() ? kFirstCapacity : m_capacity * 2;
+        T *const data = Arena::getInstance().allocateArray<T>(capacity);
+        if (m_size != 0) {
+            std::memcpy(static_cast<void *>(data), this->data(),
+                        sizeof(T) * m_size);
+        }
+        m_data = data;
+        m_capacity = capacity;
+    }
+};
+
+#endif
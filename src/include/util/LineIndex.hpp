@@ -0,0 +1,37 @@
+#ifndef UTIL_LINE_INDEX_H
+#define UTIL_LINE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Start offsets of the lines of a source buffer, so that a line can be
+// fetched by its number without keeping a copy of every line around.
+//
+// The index is built with a single memchr() pass the first time a line is
+// asked for; compilations that report no diagnostic never pay for it.
+// Offsets are 32-bit, which limits the source to 4 GiB.
+class LineIndex {
+  private:
+    const char *m_source;
+    size_t m_source_size;
+    // m_line_starts[i] is the offset of line i + 1
+    std::vector<uint32_t> m_line_starts;
+    bool m_is_built = false;
+
+  public:
+    ~LineIndex() = default;
+    LineIndex(const char *const p_source, const size_t p_source_size)
+        : m_source(p_source), m_source_size(p_source_size) {}
+
+    size_t getNumOfLines();
+    // line numbers start from 1; the returned view excludes the newline and
+    // is empty for a line that does not exist
+    std::string_view getLine(const uint32_t p_line);
+
+  private:
+    void build();
+};
+
+#endif
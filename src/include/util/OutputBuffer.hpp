@@ -0,0 +1,74 @@
+#ifndef UTIL_OUTPUT_BUFFER_H
+#define UTIL_OUTPUT_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+// Collects small writes in a buffer of its own and hands them to a FILE in
+// large blocks, for output made of many short pieces such as an AST dump,
+// where a stdio call per piece would cost more than formatting it. What is
+// buffered reaches the FILE on flush() and on destruction; a writer that
+// shares the FILE has to flush() before the FILE is written to otherwise.
+class OutputBuffer {
+  private:
+    static constexpr size_t kCapacity = 256 * 1024;
+
+    FILE *m_file;
+    std::unique_ptr<char[]> m_data;
+    size_t m_size = 0;
+
+  public:
+    ~OutputBuffer() { flush(); }
+    explicit OutputBuffer(FILE *const p_file)
+        : m_file(p_file), m_data(new char[kCapacity]) {}
+
+    OutputBuffer(const OutputBuffer &) = delete;
+    OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+    void write(const char *const p_data, const size_t p_size) {
+        if (p_size > kCapacity - m_size) {
+            writeLarge(p_data, p_size);
+            return;
+        }
+        std::memcpy(m_data.get() + m_size, p_data, p_size);
+        m_size += p_size;
+    }
+    void write(const std::string_view p_string) {
+        write(p_string.data(), p_string.size());
+    }
+    void write(const char *const p_string) {
+        write(p_string, std::strlen(p_string));
+    }
+
+    void put(const char p_char) {
+        if (m_size == kCapacity) {
+            flush();
+        }
+        m_data[m_size++] = p_char;
+    }
+
+    void putSpaces(size_t p_num_of_spaces);
+
+    // in decimal
+    void putUnsigned(uint32_t p_value) {
+        char digits[10];
+        char *const end = digits + sizeof(digits);
+        char *begin = end;
+        do {
+            *--begin = static_cast<char>('0' + p_value % 10);
+            p_value /= 10;
+        } while (p_value != 0);
+        write(begin, end - begin);
+    }
+
+    void flush();
+
+  private:
+    void writeLarge(const char *const p_data, const size_t p_size);
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef UTIL_SCOPED_INSTANCE_H
+#define UTIL_SCOPED_INSTANCE_H
+
+#include <stdexcept>
+
+// The instance of T that code which has none at hand uses, for the tables
+// that each compilation has of its own: getInstance() returns the instance
+// of the innermost Scope on the calling thread. T derives from
+// ScopedInstance<T>, which gives it T::Scope and T::getInstance().
+//
+// Outside of any Scope there is no instance, and getInstance() throws
+// std::logic_error rather than hand out one that compilations would share.
+// Nor is an instance locked: threads with a Scope of the same instance may
+// only read it at the same time.
+template <typename T> class ScopedInstance {
+  private:
+    // the instance of the innermost Scope on this thread
+    static inline thread_local T *s_current = nullptr;
+
+  public:
+    // Makes an instance the one that getInstance() returns on this thread
+    // for the lifetime of the scope. Scopes nest.
+    class Scope {
+      private:
+        T *m_previous;
+
+      public:
+        ~Scope() { s_current = m_previous; }
+        explicit Scope(T &p_instance) : m_previous(s_current) {
+            s_current = &p_instance;
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+    static T &getInstance() {
+        if (s_current == nullptr) {
+            throw std::logic_error("no Scope of the table on this thread");
+        }
+        return *s_current;
+    }
+
+  protected:
+    ~ScopedInstance() = default;
+};
+
+#endif
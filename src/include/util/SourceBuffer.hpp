@@ -0,0 +1,46 @@
+#ifndef UTIL_SOURCE_BUFFER_H
+#define UTIL_SOURCE_BUFFER_H
+
+#include <cstddef>
+
+// The whole input in one contiguous buffer that the scanner works on in place.
+//
+// yy_scan_buffer() needs two trailing NUL bytes and may write into the buffer
+// while scanning, so the file is mapped privately (copy-on-write) with the
+// padding bytes backed by zero-filled memory. Inputs that cannot be mapped
+// (pipes, empty files) or callers that opt out are read into a heap buffer,
+// as are sources that are already in memory.
+class SourceBuffer {
+  public:
+    static constexpr size_t kNumOfPaddingBytes = 2;
+
+  private:
+    char *m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_mapping_length = 0; // 0 if the buffer lives on the heap
+
+  public:
+    ~SourceBuffer();
+    SourceBuffer() = default;
+
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    // returns false and leaves errno set on failure
+    bool open(const char *const p_path, const bool p_use_mmap);
+    // copies a source held in memory; returns false on allocation failure
+    bool assign(const char *const p_data, const size_t p_size);
+
+    char *getData() { return m_data; }
+    const char *getData() const { return m_data; }
+    // size of the source itself, not counting the padding
+    size_t getSize() const { return m_size; }
+    bool isMapped() const { return m_mapping_length != 0; }
+
+  private:
+    bool map(const int p_fd, const size_t p_size);
+    bool read(const int p_fd);
+    void release();
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef UTIL_SPSC_RING_H
+#define UTIL_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Lock-free ring buffer for exactly one producer thread and one consumer
+// thread.
+//
+// The slots are constructed up front and reused, so that a slot can keep
+// the storage it grew (e.g. vectors) from one round to the next. The
+// producer fills the slot returned by getPushSlot() in place and then
+// publishes it with push(); the consumer reads getFrontSlot() in place and
+// hands it back with pop().
+template <typename T> class SpscRing {
+  private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    std::vector<T> m_slots;
+    size_t m_mask;
+
+    // the counters only grow; each one is written by a single side
+    alignas(kCacheLineSize) std::atomic<size_t> m_head{0}; // next to pop
+    alignas(kCacheLineSize) std::atomic<size_t> m_tail{0}; // next to push
+
+  public:
+    ~SpscRing() = default;
+    // p_capacity must be a power of 2
+    explicit SpscRing(const size_t p_capacity)
+        : m_slots(p_capacity), m_mask(p_capacity - 1) {}
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // producer side; nullptr if the ring is full
+    T *getPushSlot() {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_slots.size()) {
+            return nullptr;
+        }
+        return &m_slots[tail & m_mask];
+    }
+    void push() {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_release);
+    }
+
+    // consumer side; nullptr if the ring is empty
+    T *getFrontSlot() {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &m_slots[head & m_mask];
+    }
+    void pop() {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_release);
+    }
+};
+
+#endif
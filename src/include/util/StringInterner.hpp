@@ -0,0 +1,66 @@
+#ifndef UTIL_STRING_INTERNER_H
+#define UTIL_STRING_INTERNER_H
+
+#include "util/ScopedInstance.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// A small integer standing for an interned spelling. Two atoms are equal if
+// and only if their spellings are.
+using Atom = uint32_t;
+
+// Table that stores every distinct identifier spelling once, of the running
+// compilation for getInstance() (see util/ScopedInstance.hpp).
+//
+// Spellings are copied NUL-terminated into fixed-size blocks that never move,
+// so the C strings handed out stay valid for the lifetime of the table.
+class StringInterner : public ScopedInstance<StringInterner> {
+  public:
+    // the empty spelling, interned up front
+    static constexpr Atom kEmptyAtom = 0;
+
+  private:
+    static constexpr size_t kBlockSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    size_t m_block_remaining = 0;
+    char *m_block_cursor = nullptr;
+
+    std::vector<std::string_view> m_spellings; // indexed by atom
+    std::unordered_map<std::string_view, Atom> m_atoms;
+
+  public:
+    ~StringInterner() = default;
+    // a private table; most code uses the one of getInstance()
+    StringInterner();
+    StringInterner(const StringInterner &) = delete;
+    StringInterner &operator=(const StringInterner &) = delete;
+
+    Atom intern(const std::string_view p_spelling);
+
+    std::string_view getString(const Atom p_atom) const {
+        return m_spellings[p_atom];
+    }
+    const char *getCString(const Atom p_atom) const {
+        return m_spellings[p_atom].data();
+    }
+    size_t getNumOfAtoms() const { return m_spellings.size(); }
+
+  private:
+    const char *store(const std::string_view p_spelling);
+};
+
+inline Atom internString(const std::string_view p_spelling) {
+    return StringInterner::getInstance().intern(p_spelling);
+}
+
+inline const char *getAtomCString(const Atom p_atom) {
+    return StringInterner::getInstance().getCString(p_atom);
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef UTIL_STRING_LITERAL_POOL_H
+#define UTIL_STRING_LITERAL_POOL_H
+
+#include "util/ScopedInstance.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Index of a decoded string literal in the StringLiteralPool.
+using StringLiteralId = uint32_t;
+
+// Constant pool holding every distinct string literal of the program once;
+// getInstance() is that of the running compilation (see
+// util/ScopedInstance.hpp).
+//
+// The decoded bytes of all literals are packed NUL-terminated into one
+// contiguous arena, which doubles as a read-only data section for a backend.
+// Literals are addressed by id rather than by pointer since the arena may
+// move while it grows.
+class StringLiteralPool : public ScopedInstance<StringLiteralPool> {
+  private:
+    struct Literal {
+        uint32_t offset; // into m_data
+        uint32_t length; // without the terminating NUL
+        size_t hash;
+    };
+
+    static constexpr uint32_t kEmptySlot = UINT32_MAX;
+
+    std::vector<char> m_data;
+    std::vector<Literal> m_literals; // indexed by id
+    // open-addressing table of ids, its size is always a power of 2
+    std::vector<StringLiteralId> m_slots;
+
+  public:
+    ~StringLiteralPool() = default;
+    // a private pool; most code uses the one of getInstance()
+    StringLiteralPool() : m_slots(64, kEmptySlot) {}
+    StringLiteralPool(const StringLiteralPool &) = delete;
+    StringLiteralPool &operator=(const StringLiteralPool &) = delete;
+
+    StringLiteralId add(const std::string_view p_literal);
+
+    std::string_view getString(const StringLiteralId p_id) const {
+        const Literal &literal = m_literals[p_id];
+        return {m_data.data() + literal.offset, literal.length};
+    }
+    const char *getCString(const StringLiteralId p_id) const {
+        return m_data.data() + m_literals[p_id].offset;
+    }
+    size_t getNumOfLiterals() const { return m_literals.size(); }
+
+    // the arena itself, with offsets as given by getOffset()
+    const char *getData() const { return m_data.data(); }
+    size_t getDataSize() const { return m_data.size(); }
+    uint32_t getOffset(const StringLiteralId p_id) const {
+        return m_literals[p_id].offset;
+    }
+
+  private:
+    void grow();
+};
+
+inline StringLiteralId addStringLiteral(const std::string_view p_literal) {
+    return StringLiteralPool::getInstance().add(p_literal);
+}
+
+inline const char *getStringLiteralCString(const StringLiteralId p_id) {
+    return StringLiteralPool::getInstance().getCString(p_id);
+}
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef VISITOR_AST_STATIC_VISITOR_H
+#define VISITOR_AST_STATIC_VISITOR_H
+
+#include "visitor/AstNodeInclude.hpp"
+
+#include <type_traits>
+
+// Calls p_function with p_node cast to its class, which AstNode::getKind()
+// tells.
+template <typename Function>
+void castByKind(AstNode &p_node, Function &&p_function) {
+    switch (p_node.getKind()) {
+    case AstNodeKind::kProgram:
+        p_function(static_cast<ProgramNode &>(p_node));
+        break;
+    case AstNodeKind::kDecl:
+        p_function(static_cast<DeclNode &>(p_node));
+        break;
+    case AstNodeKind::kVariable:
+        p_function(static_cast<VariableNode &>(p_node));
+        break;
+    case AstNodeKind::kConstantValue:
+        p_function(static_cast<ConstantValueNode &>(p_node));
+        break;
+    case AstNodeKind::kFunction:
+        p_function(static_cast<FunctionNode &>(p_node));
+        break;
+    case AstNodeKind::kCompoundStatement:
+        p_function(static_cast<CompoundStatementNode &>(p_node));
+        break;
+    case AstNodeKind::kPrint:
+        p_function(static_cast<PrintNode &>(p_node));
+        break;
+    case AstNodeKind::kBinaryOperator:
+        p_function(static_cast<BinaryOperatorNode &>(p_node));
+        break;
+    case AstNodeKind::kUnaryOperator:
+        p_function(static_cast<UnaryOperatorNode &>(p_node));
+        break;
+    case AstNodeKind::kFunctionInvocation:
+        p_function(static_cast<FunctionInvocationNode &>(p_node));
+        break;
+    case AstNodeKind::kVariableReference:
+        p_function(static_cast<VariableReferenceNode &>(p_node));
+        break;
+    case AstNodeKind::kAssignment:
+        p_function(static_cast<AssignmentNode &>(p_node));
+        break;
+    case AstNodeKind::kRead:
+        p_function(static_cast<ReadNode &>(p_node));
+        break;
+    case AstNodeKind::kIf:
+        p_function(static_cast<IfNode &>(p_node));
+        break;
+    case AstNodeKind::kWhile:
+        p_function(static_cast<WhileNode &>(p_node));
+        break;
+    case AstNodeKind::kFor:
+        p_function(static_cast<ForNode &>(p_node));
+        break;
+    case AstNodeKind::kReturn:
+        p_function(static_cast<ReturnNode &>(p_node));
+        break;
+    }
+}
+
+// A visitor dispatched at compile time, for passes that walk the whole
+// AST. Derived defines visit() for the classes of node it handles, and
+// dispatch() calls the one for a node, switching on AstNode::getKind(), or
+// directly where the class of the node is known statically (the body of an
+// IfNode, say). There is no virtual call on the way, so the compiler can
+// inline the handlers, and a visit() that Derived leaves out is an empty
+// inline function.
+//
+// A Derived that defines only some of the visit() overloads brings in the
+// others with `using AstStaticVisitor<Derived>::visit;`. As with
+// AstNodeVisitor, a visit() reaches the children of a node only if it calls
+// visitChildNodes().
+template <typename Derived> class AstStaticVisitor {
+  public:
+    template <typename Node> void dispatch(Node &p_node) {
+        if constexpr (std::is_final<Node>::value) {
+            derived().visit(p_node);
+        } else {
+            dispatchByKind(p_node);
+        }
+    }
+
+    // dispatches each child of p_node, in the order of
+    // AstNode::visitChildNodes()
+    template <typename Node> void visitChildNodes(Node &p_node) {
+        p_node.forEachChild([this](auto &p_child) { dispatch(p_child); });
+    }
+
+    void visit(ProgramNode &p_program) {}
+    void visit(DeclNode &p_decl) {}
+    void visit(VariableNode &p_variable) {}
+    void visit(ConstantValueNode &p_constant_value) {}
+    void visit(FunctionNode &p_function) {}
+    void visit(CompoundStatementNode &p_compound_statement) {}
+    void visit(PrintNode &p_print) {}
+    void visit(BinaryOperatorNode &p_bin_op) {}
+    void visit(UnaryOperatorNode &p_un_op) {}
+    void visit(FunctionInvocationNode &p_func_invocation) {}
+    void visit(VariableReferenceNode &p_variable_ref) {}
+    void visit(AssignmentNode &p_assignment) {}
+    void visit(ReadNode &p_read) {}
+    void visit(IfNode &p_if) {}
+    void visit(WhileNode &p_while) {}
+    void visit(ForNode &p_for) {}
+    void visit(ReturnNode &p_return) {}
+
+  protected:
+    ~AstStaticVisitor() = default;
+
+  private:
+    Derived &derived() { return static_cast<Derived &>(*this); }
+
+    void dispatchByKind(AstNode &p_node) {
+        castByKind(p_node, [this](auto &p_typed) { derived().visit(p_typed); });
+    }
+};
+
+#endif
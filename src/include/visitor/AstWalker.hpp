@@ -0,0 +1,91 @@
+#ifndef VISITOR_AST_WALKER_H
+#define VISITOR_AST_WALKER_H
+
+#include "visitor/AstStaticVisitor.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Walks a tree with a stack of its own rather than by recursion, so that the
+// native stack a pass takes does not grow with the depth of the tree: a
+// thousand nested loops, or an expression that chains a million operators,
+// are walked like a flat program. Derived defines preVisit() for the
+// classes of node it handles on the way down and postVisit() for those it
+// handles on the way up. walk() calls them in the order a recursive visitor
+// that works before and after visitChildNodes() would.
+//
+// A Derived that defines only some of the overloads brings in the empty
+// ones with `using AstWalker<Derived>::preVisit;` (and postVisit). Unlike a
+// visitor, a callback cannot skip the children of a node or visit them
+// twice.
+template <typename Derived> class AstWalker {
+  private:
+    // A node whose children are to be pushed, or with kPostVisit set, one
+    // whose postVisit() is next. Nodes are aligned, so the bit is free.
+    using Frame = uintptr_t;
+    static constexpr Frame kPostVisit = 1;
+    // kept from one walk to the next, which then need not allocate
+    std::vector<Frame> m_stack;
+
+  protected:
+    // what the empty callbacks return, so that walk() knows to skip them
+    struct Empty {};
+
+  public:
+    // may be called again from a callback, for another tree
+    void walk(AstNode &p_root) {
+        const size_t bottom = m_stack.size();
+        m_stack.push_back(reinterpret_cast<Frame>(&p_root));
+        while (m_stack.size() > bottom) {
+            const Frame frame = m_stack.back();
+            m_stack.pop_back();
+            AstNode &node = *reinterpret_cast<AstNode *>(frame & ~kPostVisit);
+            if (frame & kPostVisit) {
+                castByKind(node, [this](auto &p_node) {
+                    derived().postVisit(p_node);
+                });
+            } else {
+                castByKind(node, [this](auto &p_node) { enter(p_node); });
+            }
+        }
+    }
+
+    template <typename Node> Empty preVisit(Node &) { return {}; }
+    template <typename Node> Empty postVisit(Node &) { return {}; }
+
+  protected:
+    ~AstWalker() = default;
+
+  private:
+    Derived &derived() { return static_cast<Derived &>(*this); }
+
+    template <typename Node> void enter(Node &p_node) {
+        derived().preVisit(p_node);
+        if constexpr (std::is_same<decltype(derived().postVisit(p_node)),
+                                   Empty>::value) {
+            pushChildren(p_node);
+            return;
+        }
+        m_stack.push_back(reinterpret_cast<Frame>(&p_node) | kPostVisit);
+        if (!pushChildren(p_node)) {
+            // a leaf, about half of the nodes, is done at once
+            m_stack.pop_back();
+            derived().postVisit(p_node);
+        }
+    }
+
+    // the first child on top; returns whether there were any
+    template <typename Node> bool pushChildren(Node &p_node) {
+        const size_t first = m_stack.size();
+        p_node.forEachChild([this](AstNode &p_child) {
+            m_stack.push_back(reinterpret_cast<Frame>(&p_child));
+        });
+        std::reverse(m_stack.begin() + first, m_stack.end());
+        return m_stack.size() != first;
+    }
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef VISITOR_FLAT_AST_VISITOR_H
+#define VISITOR_FLAT_AST_VISITOR_H
+
+#include "AST/FlatAst.hpp"
+
+// AstNodeVisitor for a FlatAst: a visit() per kind of node, which gets the
+// node and its id, for FlatAst::getLocation(), and for FlatAst::walk() a
+// leave() once the nodes under it are visited.
+class FlatAstVisitor {
+  public:
+    using NodeId = FlatAst::NodeId;
+
+    virtual ~FlatAstVisitor() = 0;
+
+    virtual void visit(NodeId p_id, const FlatAst::Program &p_program) {}
+    virtual void visit(NodeId p_id, const FlatAst::Decl &p_decl) {}
+    virtual void visit(NodeId p_id, const FlatAst::Variable &p_variable) {}
+    virtual void visit(NodeId p_id,
+                       const FlatAst::ConstantValue &p_constant_value) {}
+    virtual void visit(NodeId p_id, const FlatAst::Function &p_function) {}
+    virtual void
+    visit(NodeId p_id,
+          const FlatAst::CompoundStatement &p_compound_statement) {}
+    virtual void visit(NodeId p_id, const FlatAst::Print &p_print) {}
+    virtual void visit(NodeId p_id,
+                       const FlatAst::BinaryOperator &p_bin_op) {}
+    virtual void visit(NodeId p_id, const FlatAst::UnaryOperator &p_un_op) {}
+    virtual void
+    visit(NodeId p_id, const FlatAst::FunctionInvocation &p_func_invocation) {}
+    virtual void visit(NodeId p_id,
+                       const FlatAst::VariableReference &p_variable_ref) {}
+    virtual void visit(NodeId p_id,
+                       const FlatAst::Assignment &p_assignment) {}
+    virtual void visit(NodeId p_id, const FlatAst::Read &p_read) {}
+    virtual void visit(NodeId p_id, const FlatAst::If &p_if) {}
+    virtual void visit(NodeId p_id, const FlatAst::While &p_while) {}
+    virtual void visit(NodeId p_id, const FlatAst::For &p_for) {}
+    virtual void visit(NodeId p_id, const FlatAst::Return &p_return) {}
+
+    virtual void leave(NodeId p_id) {}
+};
+
+#endif
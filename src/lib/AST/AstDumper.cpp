@@ -17,8 +17,6 @@
 #include "AST/variable.hpp"
 #include "AST/while.hpp"
 
-#include <cstdio>
-
 void AstDumper::incrementIndentation() {
     m_indentation += m_indentation_stride;
 }
@@ -27,202 +25,150 @@ void AstDumper::decrementIndentation() {
     m_indentation -= m_indentation_stride;
 }
 
-static void outputIndentationSpace(const uint32_t indentation) {
-    std::printf("%*s", indentation, "");
+void AstDumper::outputNodeHeader(const char *const p_name,
+                                 const Location &p_location) {
+    m_output.putSpaces(m_indentation);
+    m_output.write(p_name);
+    m_output.write(" <line: ");
+    m_output.putUnsigned(p_location.line);
+    m_output.write(", col: ");
+    m_output.putUnsigned(p_location.col);
+    m_output.put('>');
 }
 
-void AstDumper::visit(ProgramNode &p_program) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("program <line: %u, col: %u> %s %s\n",
-                p_program.getLocation().line, p_program.getLocation().col,
-                p_program.getNameCString(), "void");
+void AstDumper::preVisit(ProgramNode &p_program) {
+    outputNodeHeader("program", p_program.getLocation());
+    m_output.put(' ');
+    m_output.write(p_program.getNameCString());
+    m_output.write(" void\n");
 
     incrementIndentation();
-    p_program.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(DeclNode &p_decl) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("declaration <line: %u, col: %u>\n", p_decl.getLocation().line,
-                p_decl.getLocation().col);
+void AstDumper::preVisit(DeclNode &p_decl) {
+    outputNodeHeader("declaration", p_decl.getLocation());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_decl.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(VariableNode &p_variable) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("variable <line: %u, col: %u> %s %s\n",
-                p_variable.getLocation().line, p_variable.getLocation().col,
-                p_variable.getNameCString(), p_variable.getTypeCString());
+void AstDumper::preVisit(VariableNode &p_variable) {
+    outputNodeHeader("variable", p_variable.getLocation());
+    m_output.put(' ');
+    m_output.write(p_variable.getNameCString());
+    m_output.put(' ');
+    m_output.write(p_variable.getTypeCString());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_variable.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(ConstantValueNode &p_constant_value) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("constant <line: %u, col: %u> %s\n",
-                p_constant_value.getLocation().line,
-                p_constant_value.getLocation().col,
-                p_constant_value.getConstantValueCString());
+void AstDumper::preVisit(ConstantValueNode &p_constant_value) {
+    outputNodeHeader("constant", p_constant_value.getLocation());
+    m_output.put(' ');
+    m_output.write(p_constant_value.getConstantValueCString());
+    m_output.put('\n');
 }
 
-void AstDumper::visit(FunctionNode &p_function) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("function declaration <line: %u, col: %u> %s %s\n",
-                p_function.getLocation().line, p_function.getLocation().col,
-                p_function.getNameCString(), p_function.getPrototypeCString());
+void AstDumper::preVisit(FunctionNode &p_function) {
+    outputNodeHeader("function declaration", p_function.getLocation());
+    m_output.put(' ');
+    m_output.write(p_function.getNameCString());
+    m_output.put(' ');
+    m_output.write(p_function.getPrototypeCString());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_function.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(CompoundStatementNode &p_compound_statement) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("compound statement <line: %u, col: %u>\n",
-                p_compound_statement.getLocation().line,
-                p_compound_statement.getLocation().col);
+void AstDumper::preVisit(CompoundStatementNode &p_compound_statement) {
+    outputNodeHeader("compound statement", p_compound_statement.getLocation());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_compound_statement.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(PrintNode &p_print) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("print statement <line: %u, col: %u>\n",
-                p_print.getLocation().line, p_print.getLocation().col);
+void AstDumper::preVisit(PrintNode &p_print) {
+    outputNodeHeader("print statement", p_print.getLocation());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_print.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(BinaryOperatorNode &p_bin_op) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("binary operator <line: %u, col: %u> %s\n",
-                p_bin_op.getLocation().line, p_bin_op.getLocation().col,
-                p_bin_op.getOpCString());
+void AstDumper::preVisit(BinaryOperatorNode &p_bin_op) {
+    outputNodeHeader("binary operator", p_bin_op.getLocation());
+    m_output.put(' ');
+    m_output.write(p_bin_op.getOpCString());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_bin_op.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(UnaryOperatorNode &p_un_op) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("unary operator <line: %u, col: %u> %s\n",
-                p_un_op.getLocation().line, p_un_op.getLocation().col,
-                p_un_op.getOpCString());
+void AstDumper::preVisit(UnaryOperatorNode &p_un_op) {
+    outputNodeHeader("unary operator", p_un_op.getLocation());
+    m_output.put(' ');
+    m_output.write(p_un_op.getOpCString());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_un_op.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(FunctionInvocationNode &p_func_invocation) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("function invocation <line: %u, col: %u> %s\n",
-                p_func_invocation.getLocation().line,
-                p_func_invocation.getLocation().col,
-                p_func_invocation.getNameCString());
+void AstDumper::preVisit(FunctionInvocationNode &p_func_invocation) {
+    outputNodeHeader("function invocation", p_func_invocation.getLocation());
+    m_output.put(' ');
+    m_output.write(p_func_invocation.getNameCString());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_func_invocation.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(VariableReferenceNode &p_variable_ref) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("variable reference <line: %u, col: %u> %s\n",
-                p_variable_ref.getLocation().line,
-                p_variable_ref.getLocation().col,
-                p_variable_ref.getNameCString());
+void AstDumper::preVisit(VariableReferenceNode &p_variable_ref) {
+    outputNodeHeader("variable reference", p_variable_ref.getLocation());
+    m_output.put(' ');
+    m_output.write(p_variable_ref.getNameCString());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_variable_ref.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(AssignmentNode &p_assignment) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("assignment statement <line: %u, col: %u>\n",
-                p_assignment.getLocation().line,
-                p_assignment.getLocation().col);
+void AstDumper::preVisit(AssignmentNode &p_assignment) {
+    outputNodeHeader("assignment statement", p_assignment.getLocation());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_assignment.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(ReadNode &p_read) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("read statement <line: %u, col: %u>\n",
-                p_read.getLocation().line, p_read.getLocation().col);
+void AstDumper::preVisit(ReadNode &p_read) {
+    outputNodeHeader("read statement", p_read.getLocation());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_read.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(IfNode &p_if) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("if statement <line: %u, col: %u>\n", p_if.getLocation().line,
-                p_if.getLocation().col);
+void AstDumper::preVisit(IfNode &p_if) {
+    outputNodeHeader("if statement", p_if.getLocation());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_if.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(WhileNode &p_while) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("while statement <line: %u, col: %u>\n",
-                p_while.getLocation().line, p_while.getLocation().col);
+void AstDumper::preVisit(WhileNode &p_while) {
+    outputNodeHeader("while statement", p_while.getLocation());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_while.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(ForNode &p_for) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("for statement <line: %u, col: %u>\n", p_for.getLocation().line,
-                p_for.getLocation().col);
+void AstDumper::preVisit(ForNode &p_for) {
+    outputNodeHeader("for statement", p_for.getLocation());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_for.visitChildNodes(*this);
-    decrementIndentation();
 }
 
-void AstDumper::visit(ReturnNode &p_return) {
-    outputIndentationSpace(m_indentation);
-
-    std::printf("return statement <line: %u, col: %u>\n",
-                p_return.getLocation().line, p_return.getLocation().col);
+void AstDumper::preVisit(ReturnNode &p_return) {
+    outputNodeHeader("return statement", p_return.getLocation());
+    m_output.put('\n');
 
     incrementIndentation();
-    p_return.visitChildNodes(*this);
-    decrementIndentation();
 }
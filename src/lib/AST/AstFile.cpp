@@ -0,0 +1,662 @@
+#include "AST/AstFile.hpp"
+
+#include "AST/PType.hpp"
+#include "AST/constant.hpp"
+#include "AST/utils.hpp"
+#include "util/Arena.hpp"
+#include "util/StringInterner.hpp"
+#include "util/StringLiteralPool.hpp"
+#include "visitor/AstWalker.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+// the types that every TypeContext starts with, under the same ids
+constexpr TypeId kNumOfPredefinedTypes = TypeContext::kStringType + 1;
+
+// Walks the tree rather than recursing, so that a deep one is written like a
+// flat one; the words of a node precede those of its children either way.
+class AstWriter final : public AstWalker<AstWriter> {
+  private:
+    std::vector<uint32_t> &m_words;
+    // the constant of the last DeclNode, written with it rather than under
+    // each of its variables
+    const ConstantValueNode *m_decl_constant = nullptr;
+
+  public:
+    ~AstWriter() = default;
+    explicit AstWriter(std::vector<uint32_t> &p_words) : m_words(p_words) {}
+
+    // VariableNode: written with its DeclNode
+    using AstWalker<AstWriter>::preVisit;
+
+    void writeTables() {
+        const StringInterner &atoms = StringInterner::getInstance();
+        m_words.push_back(atoms.getNumOfAtoms());
+        for (Atom atom = 0; atom < atoms.getNumOfAtoms(); ++atom) {
+            writeString(atoms.getString(atom));
+        }
+
+        const StringLiteralPool &literals = StringLiteralPool::getInstance();
+        m_words.push_back(literals.getNumOfLiterals());
+        for (StringLiteralId id = 0; id < literals.getNumOfLiterals(); ++id) {
+            writeString(literals.getString(id));
+        }
+
+        const TypeContext &types = TypeContext::getInstance();
+        m_words.push_back(types.getNumOfTypes() - kNumOfPredefinedTypes);
+        for (TypeId id = kNumOfPredefinedTypes; id < types.getNumOfTypes();
+             ++id) {
+            const PType &type = types.getType(id);
+            m_words.push_back(static_cast<uint32_t>(type.getPrimitiveType()));
+            m_words.push_back(type.getNumOfDimensions());
+            for (const uint64_t dimension : type.getDimensions()) {
+                write64(dimension);
+            }
+        }
+    }
+
+    void preVisit(ProgramNode &p_program) {
+        writeNodeHeader(p_program);
+        m_words.push_back(p_program.getName());
+        m_words.push_back(p_program.getReturnType());
+        writeNumOfChildren(p_program);
+    }
+
+    void preVisit(DeclNode &p_decl) {
+        writeNodeHeader(p_decl);
+        const DeclNode::VarNodes &variables = p_decl.getVariables();
+        m_words.push_back(variables.empty() ? TypeContext::kNoType
+                                            : variables[0]->getType());
+        m_words.push_back(variables.size());
+        for (const VariableNode *const variable : variables) {
+            m_words.push_back(variable->getName());
+            m_words.push_back(variable->getLocation().line);
+            m_words.push_back(variable->getLocation().col);
+        }
+        // shared by the variables
+        ConstantValueNode *const constant =
+            variables.empty() ? nullptr : variables[0]->getConstantValueNode();
+        m_words.push_back(constant != nullptr ? 1 : 0);
+        if (constant != nullptr) {
+            writeConstantValue(*constant);
+        }
+        m_decl_constant = constant;
+    }
+
+    void preVisit(ConstantValueNode &p_constant_value) {
+        if (&p_constant_value != m_decl_constant) {
+            writeConstantValue(p_constant_value);
+        }
+    }
+
+    void preVisit(FunctionNode &p_function) {
+        writeNodeHeader(p_function);
+        m_words.push_back(p_function.getName());
+        m_words.push_back(p_function.getReturnType());
+        writeNumOfChildren(p_function);
+    }
+
+    void preVisit(CompoundStatementNode &p_compound_statement) {
+        writeNodeHeader(p_compound_statement);
+        writeNumOfChildren(p_compound_statement);
+    }
+
+    void preVisit(PrintNode &p_print) {
+        writeNodeHeader(p_print);
+        writeNumOfChildren(p_print);
+    }
+
+    void preVisit(BinaryOperatorNode &p_bin_op) {
+        writeNodeHeader(p_bin_op);
+        m_words.push_back(static_cast<uint32_t>(p_bin_op.getOp()));
+        writeNumOfChildren(p_bin_op);
+    }
+
+    void preVisit(UnaryOperatorNode &p_un_op) {
+        writeNodeHeader(p_un_op);
+        m_words.push_back(static_cast<uint32_t>(p_un_op.getOp()));
+        writeNumOfChildren(p_un_op);
+    }
+
+    void preVisit(FunctionInvocationNode &p_func_invocation) {
+        writeNodeHeader(p_func_invocation);
+        m_words.push_back(p_func_invocation.getName());
+        writeNumOfChildren(p_func_invocation);
+    }
+
+    void preVisit(VariableReferenceNode &p_variable_ref) {
+        writeNodeHeader(p_variable_ref);
+        m_words.push_back(p_variable_ref.getName());
+        writeNumOfChildren(p_variable_ref);
+    }
+
+    void preVisit(AssignmentNode &p_assignment) {
+        writeNodeHeader(p_assignment);
+        writeNumOfChildren(p_assignment);
+    }
+
+    void preVisit(ReadNode &p_read) {
+        writeNodeHeader(p_read);
+        writeNumOfChildren(p_read);
+    }
+
+    void preVisit(IfNode &p_if) {
+        writeNodeHeader(p_if);
+        writeNumOfChildren(p_if);
+    }
+
+    void preVisit(WhileNode &p_while) {
+        writeNodeHeader(p_while);
+        writeNumOfChildren(p_while);
+    }
+
+    void preVisit(ForNode &p_for) {
+        writeNodeHeader(p_for);
+        writeNumOfChildren(p_for);
+    }
+
+    void preVisit(ReturnNode &p_return) {
+        writeNodeHeader(p_return);
+        writeNumOfChildren(p_return);
+    }
+
+  private:
+    // a leaf
+    void writeConstantValue(ConstantValueNode &p_constant_value) {
+        writeNodeHeader(p_constant_value);
+        const Constant &constant = p_constant_value.getConstant();
+        const Constant::ConstantValue value = constant.getValue();
+        m_words.push_back(constant.getType());
+        switch (getPType(constant.getType()).getPrimitiveType()) {
+        case PType::PrimitiveTypeEnum::kIntegerType:
+            write64(static_cast<uint64_t>(value.integer));
+            break;
+        case PType::PrimitiveTypeEnum::kRealType: {
+            uint64_t bits;
+            std::memcpy(&bits, &value.real, sizeof(bits));
+            write64(bits);
+            break;
+        }
+        case PType::PrimitiveTypeEnum::kBoolType:
+            m_words.push_back(value.boolean ? 1 : 0);
+            break;
+        case PType::PrimitiveTypeEnum::kStringType:
+            m_words.push_back(value.string);
+            break;
+        case PType::PrimitiveTypeEnum::kVoidType:
+            break;
+        }
+        writeNumOfChildren(p_constant_value);
+    }
+
+    void write64(const uint64_t p_value) {
+        m_words.push_back(static_cast<uint32_t>(p_value));
+        m_words.push_back(static_cast<uint32_t>(p_value >> 32));
+    }
+
+    // its length, then its bytes, padded to a whole word
+    void writeString(const std::string_view p_string) {
+        m_words.push_back(p_string.size());
+        const size_t first = m_words.size();
+        m_words.resize(first + (p_string.size() + 3) / 4, 0);
+        std::memcpy(m_words.data() + first, p_string.data(), p_string.size());
+    }
+
+    void writeNodeHeader(const AstNode &p_node) {
+        m_words.push_back(static_cast<uint32_t>(p_node.getKind()));
+        m_words.push_back(p_node.getLocation().line);
+        m_words.push_back(p_node.getLocation().col);
+    }
+
+    // the children follow as the walk reaches them
+    template <typename Node> void writeNumOfChildren(Node &p_node) {
+        uint32_t num_of_children = 0;
+        p_node.forEachChild([&](AstNode &) { ++num_of_children; });
+        m_words.push_back(num_of_children);
+    }
+};
+
+class AstReader {
+  private:
+    const uint32_t *m_cursor;
+    const uint32_t *const m_end;
+
+    // what the ids in the words are in the tables of getInstance()
+    std::vector<Atom> m_atoms;
+    std::vector<StringLiteralId> m_literals;
+    std::vector<TypeId> m_types;
+
+    // A node being read: what precedes its children in the words, and how
+    // many of them are still to be read.
+    struct Frame {
+        AstNodeKind kind;
+        uint32_t line;
+        uint32_t col;
+        uint32_t num_of_children_left;
+        // of m_children
+        size_t first_child;
+        // those of the fields of its class that it has
+        Atom name;
+        TypeId type;
+        Operator op;
+        ArenaVector<IdInfo> ids;
+        Constant *constant;
+    };
+    // the nodes from the root down to the one being read
+    std::vector<Frame> m_frames;
+    // the children of the nodes being read
+    std::vector<AstNode *> m_children;
+
+    // the children of one node, taken in order
+    class Children {
+      private:
+        AstNode *const *m_next;
+        AstNode *const *const m_end;
+
+      public:
+        Children(AstNode *const *const p_begin, AstNode *const *const p_end)
+            : m_next(p_begin), m_end(p_end) {}
+
+        bool isEmpty() const { return m_next == m_end; }
+        bool nextIs(const AstNodeKind p_kind) const {
+            return m_next != m_end && (*m_next)->getKind() == p_kind;
+        }
+
+        AstNode *take() {
+            if (m_next == m_end) {
+                throw std::runtime_error("too few children");
+            }
+            return *m_next++;
+        }
+        template <typename Node> Node *take() {
+            AstNode *const node = take();
+            if (node->getKind() != Node::kKind) {
+                throw std::runtime_error("child of the wrong class");
+            }
+            return static_cast<Node *>(node);
+        }
+        ExpressionNode *takeExpression() {
+            AstNode *const node = take();
+            switch (node->getKind()) {
+            case AstNodeKind::kConstantValue:
+            case AstNodeKind::kBinaryOperator:
+            case AstNodeKind::kUnaryOperator:
+            case AstNodeKind::kFunctionInvocation:
+            case AstNodeKind::kVariableReference:
+                return static_cast<ExpressionNode *>(node);
+            default:
+                throw std::runtime_error("child is not an expression");
+            }
+        }
+        AstNode *takeStatement() {
+            AstNode *const node = take();
+            switch (node->getKind()) {
+            case AstNodeKind::kCompoundStatement:
+            case AstNodeKind::kPrint:
+            case AstNodeKind::kFunctionInvocation:
+            case AstNodeKind::kAssignment:
+            case AstNodeKind::kRead:
+            case AstNodeKind::kIf:
+            case AstNodeKind::kWhile:
+            case AstNodeKind::kFor:
+            case AstNodeKind::kReturn:
+                return node;
+            default:
+                throw std::runtime_error("child is not a statement");
+            }
+        }
+        template <typename Node> ArenaVector<Node *> takeAll() {
+            ArenaVector<Node *> nodes;
+            while (nextIs(Node::kKind)) {
+                nodes.push_back(take<Node>());
+            }
+            return nodes;
+        }
+        ArenaVector<ExpressionNode *> takeExpressions() {
+            ArenaVector<ExpressionNode *> nodes;
+            while (!isEmpty()) {
+                nodes.push_back(takeExpression());
+            }
+            return nodes;
+        }
+        void finish() const {
+            if (m_next != m_end) {
+                throw std::runtime_error("too many children");
+            }
+        }
+    };
+
+  public:
+    ~AstReader() = default;
+    AstReader(const uint32_t *const p_words, const size_t p_num_of_words)
+        : m_cursor(p_words), m_end(p_words + p_num_of_words) {}
+
+    AstReader(const AstReader &) = delete;
+    AstReader &operator=(const AstReader &) = delete;
+
+    void readTables() {
+        StringInterner &atoms = StringInterner::getInstance();
+        m_atoms.resize(readCount());
+        for (Atom &atom : m_atoms) {
+            atom = atoms.intern(readString());
+        }
+
+        StringLiteralPool &literals = StringLiteralPool::getInstance();
+        m_literals.resize(readCount());
+        for (StringLiteralId &literal : m_literals) {
+            literal = literals.add(readString());
+        }
+
+        TypeContext &types = TypeContext::getInstance();
+        m_types.resize(kNumOfPredefinedTypes + readCount());
+        for (TypeId id = 0; id < kNumOfPredefinedTypes; ++id) {
+            m_types[id] = id;
+        }
+        std::vector<uint64_t> dimensions;
+        for (TypeId id = kNumOfPredefinedTypes; id < m_types.size(); ++id) {
+            const uint32_t primitive = read();
+            if (primitive > static_cast<uint32_t>(
+                                PType::PrimitiveTypeEnum::kStringType)) {
+                throw std::runtime_error("unknown primitive type");
+            }
+            dimensions.resize(readCount());
+            for (uint64_t &dimension : dimensions) {
+                dimension = read64();
+            }
+            m_types[id] = types.intern(
+                static_cast<PType::PrimitiveTypeEnum>(primitive),
+                dimensions.data(), dimensions.size());
+        }
+    }
+
+    // Reads the nodes with a stack of its own rather than by recursion, so
+    // that a deep tree is read like a flat one.
+    AstNode *readTree() {
+        m_frames.clear();
+        readFrame();
+        for (;;) {
+            if (m_frames.back().num_of_children_left > 0) {
+                --m_frames.back().num_of_children_left;
+                readFrame();
+                continue;
+            }
+            const Frame &frame = m_frames.back();
+            Children children(m_children.data() + frame.first_child,
+                              m_children.data() + m_children.size());
+            AstNode *const node = makeNode(frame, children);
+            children.finish();
+            m_children.resize(frame.first_child);
+            m_frames.pop_back();
+            if (m_frames.empty()) {
+                return node;
+            }
+            m_children.push_back(node);
+        }
+    }
+    bool isAtEnd() const { return m_cursor == m_end; }
+
+  private:
+    uint32_t read() {
+        if (m_cursor == m_end) {
+            throw std::runtime_error("truncated");
+        }
+        return *m_cursor++;
+    }
+    uint64_t read64() {
+        const uint64_t low = read();
+        return low | (uint64_t{read()} << 32);
+    }
+    // a number of items that take a word or more each, so that a damaged
+    // count cannot make us allocate much more than the file holds
+    uint32_t readCount() {
+        const uint32_t count = read();
+        if (count > static_cast<size_t>(m_end - m_cursor)) {
+            throw std::runtime_error("count beyond the end");
+        }
+        return count;
+    }
+    std::string_view readString() {
+        const uint32_t length = read();
+        const size_t num_of_words = (size_t{length} + 3) / 4;
+        if (num_of_words > static_cast<size_t>(m_end - m_cursor)) {
+            throw std::runtime_error("truncated string");
+        }
+        const char *const data = reinterpret_cast<const char *>(m_cursor);
+        m_cursor += num_of_words;
+        return {data, length};
+    }
+
+    Atom readAtom() { return lookUp(m_atoms, read()); }
+    TypeId readType() { return lookUp(m_types, read()); }
+    StringLiteralId readLiteral() { return lookUp(m_literals, read()); }
+    Operator readOperator() {
+        const uint32_t op = read();
+        if (op > static_cast<uint32_t>(Operator::kOrOp)) {
+            throw std::runtime_error("unknown operator");
+        }
+        return static_cast<Operator>(op);
+    }
+
+    template <typename Id>
+    static Id lookUp(const std::vector<Id> &p_ids, const uint32_t p_id) {
+        if (p_id >= p_ids.size()) {
+            throw std::runtime_error("id out of range");
+        }
+        return p_ids[p_id];
+    }
+
+    // Reads the kind and location of a node and the fields that precede its
+    // children.
+    void readFrame() {
+        Frame frame{};
+        const uint32_t kind = read();
+        if (kind >= kNumOfAstNodeKinds) {
+            throw std::runtime_error("unknown kind of node");
+        }
+        frame.kind = static_cast<AstNodeKind>(kind);
+        frame.line = read();
+        frame.col = read();
+
+        switch (frame.kind) {
+        case AstNodeKind::kProgram:
+        case AstNodeKind::kFunction:
+            frame.name = readAtom();
+            frame.type = readType();
+            break;
+        case AstNodeKind::kDecl:
+            frame.type = readType();
+            for (uint32_t num_of_ids = readCount(); num_of_ids > 0;
+                 --num_of_ids) {
+                const Atom name = readAtom();
+                const uint32_t line = read();
+                const uint32_t col = read();
+                frame.ids.emplace_back(line, col, name);
+            }
+            break;
+        case AstNodeKind::kVariable:
+            // only in a DeclNode, which has its variables inline
+            throw std::runtime_error("variable outside of a declaration");
+        case AstNodeKind::kConstantValue:
+            frame.constant = readConstant();
+            break;
+        case AstNodeKind::kBinaryOperator:
+        case AstNodeKind::kUnaryOperator:
+            frame.op = readOperator();
+            break;
+        case AstNodeKind::kFunctionInvocation:
+        case AstNodeKind::kVariableReference:
+            frame.name = readAtom();
+            break;
+        default:
+            break;
+        }
+
+        frame.num_of_children_left = readCount();
+        frame.first_child = m_children.size();
+        m_frames.push_back(frame);
+    }
+
+    Constant *readConstant() {
+        const TypeId type = readType();
+        Constant::ConstantValue value;
+        switch (getPType(type).getPrimitiveType()) {
+        case PType::PrimitiveTypeEnum::kIntegerType:
+            value.integer = static_cast<int64_t>(read64());
+            break;
+        case PType::PrimitiveTypeEnum::kRealType: {
+            const uint64_t bits = read64();
+            std::memcpy(&value.real, &bits, sizeof(bits));
+            break;
+        }
+        case PType::PrimitiveTypeEnum::kBoolType:
+            value.boolean = read() != 0;
+            break;
+        case PType::PrimitiveTypeEnum::kStringType:
+            value.string = readLiteral();
+            break;
+        case PType::PrimitiveTypeEnum::kVoidType:
+            value.integer = 0;
+            break;
+        }
+        return newInArena<Constant>(type, value);
+    }
+
+    // makes the node of a frame whose children have all been read
+    static AstNode *makeNode(const Frame &p_frame, Children &p_children) {
+        const uint32_t line = p_frame.line;
+        const uint32_t col = p_frame.col;
+
+        switch (p_frame.kind) {
+        case AstNodeKind::kProgram: {
+            const auto decls = p_children.takeAll<DeclNode>();
+            const auto functions = p_children.takeAll<FunctionNode>();
+            auto *const body = p_children.take<CompoundStatementNode>();
+            return newInArena<ProgramNode>(line, col, p_frame.name,
+                                           p_frame.type, decls, functions,
+                                           body);
+        }
+        case AstNodeKind::kDecl: {
+            if (p_children.isEmpty()) {
+                return newInArena<DeclNode>(line, col, p_frame.ids,
+                                            p_frame.type);
+            }
+            auto *const constant = p_children.take<ConstantValueNode>();
+            if (constant->getType() != p_frame.type) {
+                throw std::runtime_error("constant of another type");
+            }
+            return newInArena<DeclNode>(line, col, p_frame.ids, constant);
+        }
+        case AstNodeKind::kVariable:
+            break;
+        case AstNodeKind::kConstantValue:
+            return newInArena<ConstantValueNode>(line, col, p_frame.constant);
+        case AstNodeKind::kFunction: {
+            const auto parameters = p_children.takeAll<DeclNode>();
+            CompoundStatementNode *body = nullptr;
+            if (!p_children.isEmpty()) {
+                body = p_children.take<CompoundStatementNode>();
+            }
+            return newInArena<FunctionNode>(line, col, p_frame.name,
+                                            parameters, p_frame.type, body);
+        }
+        case AstNodeKind::kCompoundStatement: {
+            const auto decls = p_children.takeAll<DeclNode>();
+            CompoundStatementNode::StmtNodes statements;
+            while (!p_children.isEmpty()) {
+                statements.push_back(p_children.takeStatement());
+            }
+            return newInArena<CompoundStatementNode>(line, col, decls,
+                                                     statements);
+        }
+        case AstNodeKind::kPrint:
+            return newInArena<PrintNode>(line, col,
+                                         p_children.takeExpression());
+        case AstNodeKind::kBinaryOperator: {
+            ExpressionNode *const left = p_children.takeExpression();
+            ExpressionNode *const right = p_children.takeExpression();
+            return newInArena<BinaryOperatorNode>(line, col, p_frame.op, left,
+                                                  right);
+        }
+        case AstNodeKind::kUnaryOperator:
+            return newInArena<UnaryOperatorNode>(line, col, p_frame.op,
+                                                 p_children.takeExpression());
+        case AstNodeKind::kFunctionInvocation:
+            return newInArena<FunctionInvocationNode>(
+                line, col, p_frame.name, p_children.takeExpressions());
+        case AstNodeKind::kVariableReference:
+            return newInArena<VariableReferenceNode>(
+                line, col, p_frame.name, p_children.takeExpressions());
+        case AstNodeKind::kAssignment: {
+            auto *const lvalue = p_children.take<VariableReferenceNode>();
+            ExpressionNode *const expr = p_children.takeExpression();
+            return newInArena<AssignmentNode>(line, col, lvalue, expr);
+        }
+        case AstNodeKind::kRead:
+            return newInArena<ReadNode>(
+                line, col, p_children.take<VariableReferenceNode>());
+        case AstNodeKind::kIf: {
+            ExpressionNode *const condition = p_children.takeExpression();
+            auto *const body = p_children.take<CompoundStatementNode>();
+            CompoundStatementNode *else_body = nullptr;
+            if (!p_children.isEmpty()) {
+                else_body = p_children.take<CompoundStatementNode>();
+            }
+            return newInArena<IfNode>(line, col, condition, body, else_body);
+        }
+        case AstNodeKind::kWhile: {
+            ExpressionNode *const condition = p_children.takeExpression();
+            auto *const body = p_children.take<CompoundStatementNode>();
+            return newInArena<WhileNode>(line, col, condition, body);
+        }
+        case AstNodeKind::kFor: {
+            auto *const loop_var_decl = p_children.take<DeclNode>();
+            auto *const init_stmt = p_children.take<AssignmentNode>();
+            ExpressionNode *const end_condition = p_children.takeExpression();
+            auto *const body = p_children.take<CompoundStatementNode>();
+            return newInArena<ForNode>(line, col, loop_var_decl, init_stmt,
+                                       end_condition, body);
+        }
+        case AstNodeKind::kReturn:
+            return newInArena<ReturnNode>(line, col,
+                                          p_children.takeExpression());
+        }
+        throw std::runtime_error("unknown kind of node");
+    }
+};
+
+} // namespace
+
+void writeAst(ProgramNode &p_program, std::vector<uint32_t> &p_words) {
+    AstWriter writer(p_words);
+    writer.writeTables();
+    writer.walk(p_program);
+}
+
+void writeAstFile(ProgramNode &p_program, FILE *const p_output) {
+    std::vector<uint32_t> words;
+    writeAst(p_program, words);
+    const uint32_t num_of_words = static_cast<uint32_t>(words.size());
+    std::fwrite(kAstFileMagic, sizeof(kAstFileMagic), 1, p_output);
+    std::fwrite(&kAstFileVersion, sizeof(kAstFileVersion), 1, p_output);
+    std::fwrite(&num_of_words, sizeof(num_of_words), 1, p_output);
+    std::fwrite(words.data(), sizeof(uint32_t), words.size(), p_output);
+}
+
+ProgramNode *readAst(const uint32_t *const p_words,
+                     const size_t p_num_of_words) {
+    try {
+        AstReader reader(p_words, p_num_of_words);
+        reader.readTables();
+        AstNode *const root = reader.readTree();
+        if (root->getKind() != AstNodeKind::kProgram || !reader.isAtEnd()) {
+            return nullptr;
+        }
+        return static_cast<ProgramNode *>(root);
+    } catch (const std::runtime_error &) {
+        return nullptr;
+    }
+}
@@ -0,0 +1,270 @@
+#include "AST/AstJsonDumper.hpp"
+#include "AST/BinaryOperator.hpp"
+#include "AST/CompoundStatement.hpp"
+#include "AST/ConstantValue.hpp"
+#include "AST/FunctionInvocation.hpp"
+#include "AST/PType.hpp"
+#include "AST/UnaryOperator.hpp"
+#include "AST/VariableReference.hpp"
+#include "AST/assignment.hpp"
+#include "AST/decl.hpp"
+#include "AST/for.hpp"
+#include "AST/function.hpp"
+#include "AST/if.hpp"
+#include "AST/print.hpp"
+#include "AST/program.hpp"
+#include "AST/read.hpp"
+#include "AST/return.hpp"
+#include "AST/variable.hpp"
+#include "AST/while.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+// The length of the UTF-8 sequence that p_bytes starts with, or 0 if it is
+// not a valid one: a stray continuation byte, a sequence cut short, an
+// overlong form, a surrogate or a code point beyond U+10FFFF.
+size_t getUtf8SequenceLength(const unsigned char *const p_bytes) {
+    static constexpr uint32_t kMinCodePoints[] = {0, 0, 0x80, 0x800, 0x10000};
+    const unsigned char lead = p_bytes[0];
+    size_t length;
+    uint32_t code_point;
+    if (lead < 0x80) {
+        return 1;
+    } else if (lead >= 0xc2 && lead <= 0xdf) {
+        length = 2;
+        code_point = lead & 0x1f;
+    } else if ((lead & 0xf0) == 0xe0) {
+        length = 3;
+        code_point = lead & 0x0f;
+    } else if (lead >= 0xf0 && lead <= 0xf4) {
+        length = 4;
+        code_point = lead & 0x07;
+    } else {
+        return 0;
+    }
+    // the terminating NUL is no continuation byte, so this stops at it
+    for (size_t i = 1; i < length; ++i) {
+        if ((p_bytes[i] & 0xc0) != 0x80) {
+            return 0;
+        }
+        code_point = (code_point << 6) | (p_bytes[i] & 0x3f);
+    }
+    if (code_point < kMinCodePoints[length] ||
+        (code_point >= 0xd800 && code_point <= 0xdfff) ||
+        code_point > 0x10ffff) {
+        return 0;
+    }
+    return length;
+}
+
+} // namespace
+
+void AstJsonDumper::openNode(const char *const p_kind,
+                             const Location &p_location) {
+    if (!m_is_first) {
+        m_output.put(',');
+    }
+    m_output.write("{\"kind\":\"");
+    m_output.write(p_kind);
+    m_output.write("\",\"line\":");
+    m_output.putUnsigned(p_location.line);
+    m_output.write(",\"col\":");
+    m_output.putUnsigned(p_location.col);
+}
+
+void AstJsonDumper::outputField(const char *const p_name,
+                                const char *const p_value) {
+    m_output.write(",\"");
+    m_output.write(p_name);
+    m_output.write("\":");
+    outputString(p_value);
+}
+
+void AstJsonDumper::openChildren() {
+    m_output.write(",\"children\":[");
+    m_is_first = true;
+}
+
+void AstJsonDumper::closeNode() {
+    m_output.write("]}");
+    m_is_first = false;
+}
+
+void AstJsonDumper::outputString(const char *p_string) {
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+    m_output.put('"');
+    for (;;) {
+        // the longest run that needs no escape in one write, valid UTF-8
+        // included
+        const char *end = p_string;
+        for (;;) {
+            const auto byte = static_cast<unsigned char>(*end);
+            if (byte >= 0x20 && byte < 0x80 && byte != '"' && byte != '\\') {
+                ++end;
+                continue;
+            }
+            const size_t length =
+                byte >= 0x80
+                    ? getUtf8SequenceLength(
+                          reinterpret_cast<const unsigned char *>(end))
+                    : 0;
+            if (length == 0) {
+                break;
+            }
+            end += length;
+        }
+        m_output.write(p_string, end - p_string);
+        if (*end == '\0') {
+            break;
+        }
+        if (*end == '"' || *end == '\\') {
+            m_output.put('\\');
+            m_output.put(*end);
+        } else {
+            // a control character, or a byte of no valid UTF-8 sequence,
+            // which stands for the code point of its value
+            const auto code = static_cast<unsigned char>(*end);
+            m_output.write("\\u00");
+            m_output.put(kHexDigits[code >> 4]);
+            m_output.put(kHexDigits[code & 0xf]);
+        }
+        p_string = end + 1;
+    }
+    m_output.put('"');
+}
+
+void AstJsonDumper::outputResultType(const ExpressionNode &p_expression) {
+    m_output.write(",\"result_type\":");
+    const TypeId type = p_expression.getResultType();
+    if (type == TypeContext::kNoType) {
+        m_output.write("null");
+        return;
+    }
+    outputString(getTypeCString(type));
+}
+
+void AstJsonDumper::outputDeclaration(const AstNode *const p_declaration) {
+    m_output.write(",\"declaration\":");
+    if (p_declaration == nullptr) {
+        m_output.write("null");
+        return;
+    }
+    m_output.write("{\"line\":");
+    m_output.putUnsigned(p_declaration->getLocation().line);
+    m_output.write(",\"col\":");
+    m_output.putUnsigned(p_declaration->getLocation().col);
+    m_output.put('}');
+}
+
+void AstJsonDumper::preVisit(ProgramNode &p_program) {
+    openNode("program", p_program.getLocation());
+    outputField("name", p_program.getNameCString());
+    outputField("return_type", "void");
+    openChildren();
+}
+
+void AstJsonDumper::postVisit(ProgramNode &) {
+    closeNode();
+    m_output.put('\n');
+}
+
+void AstJsonDumper::preVisit(DeclNode &p_decl) {
+    openNode("declaration", p_decl.getLocation());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(VariableNode &p_variable) {
+    openNode("variable", p_variable.getLocation());
+    outputField("name", p_variable.getNameCString());
+    outputField("type", p_variable.getTypeCString());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(ConstantValueNode &p_constant_value) {
+    openNode("constant_value", p_constant_value.getLocation());
+    outputField("type", getTypeCString(p_constant_value.getType()));
+    outputField("value", p_constant_value.getConstantValueCString());
+    outputResultType(p_constant_value);
+    m_output.put('}');
+    m_is_first = false;
+}
+
+void AstJsonDumper::preVisit(FunctionNode &p_function) {
+    openNode("function", p_function.getLocation());
+    outputField("name", p_function.getNameCString());
+    outputField("prototype", p_function.getPrototypeCString());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(CompoundStatementNode &p_compound_statement) {
+    openNode("compound_statement", p_compound_statement.getLocation());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(PrintNode &p_print) {
+    openNode("print", p_print.getLocation());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(BinaryOperatorNode &p_bin_op) {
+    openNode("binary_operator", p_bin_op.getLocation());
+    outputField("operator", p_bin_op.getOpCString());
+    outputResultType(p_bin_op);
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(UnaryOperatorNode &p_un_op) {
+    openNode("unary_operator", p_un_op.getLocation());
+    outputField("operator", p_un_op.getOpCString());
+    outputResultType(p_un_op);
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(FunctionInvocationNode &p_func_invocation) {
+    openNode("function_invocation", p_func_invocation.getLocation());
+    outputField("name", p_func_invocation.getNameCString());
+    outputResultType(p_func_invocation);
+    outputDeclaration(p_func_invocation.getFunction());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(VariableReferenceNode &p_variable_ref) {
+    openNode("variable_reference", p_variable_ref.getLocation());
+    outputField("name", p_variable_ref.getNameCString());
+    outputResultType(p_variable_ref);
+    outputDeclaration(p_variable_ref.getVariable());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(AssignmentNode &p_assignment) {
+    openNode("assignment", p_assignment.getLocation());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(ReadNode &p_read) {
+    openNode("read", p_read.getLocation());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(IfNode &p_if) {
+    openNode("if", p_if.getLocation());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(WhileNode &p_while) {
+    openNode("while", p_while.getLocation());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(ForNode &p_for) {
+    openNode("for", p_for.getLocation());
+    openChildren();
+}
+
+void AstJsonDumper::preVisit(ReturnNode &p_return) {
+    openNode("return", p_return.getLocation());
+    openChildren();
+}
@@ -0,0 +1,79 @@
+#include "AST/AstStats.hpp"
+#include "util/Arena.hpp"
+#include "visitor/AstNodeInclude.hpp"
+
+namespace {
+
+struct ClassInfo {
+    const char *name;
+    size_t size;
+};
+
+// in the order of AstNodeKind
+constexpr ClassInfo kClasses[] = {
+    {"ProgramNode", sizeof(ProgramNode)},
+    {"DeclNode", sizeof(DeclNode)},
+    {"VariableNode", sizeof(VariableNode)},
+    {"ConstantValueNode", sizeof(ConstantValueNode)},
+    {"FunctionNode", sizeof(FunctionNode)},
+    {"CompoundStatementNode", sizeof(CompoundStatementNode)},
+    {"PrintNode", sizeof(PrintNode)},
+    {"BinaryOperatorNode", sizeof(BinaryOperatorNode)},
+    {"UnaryOperatorNode", sizeof(UnaryOperatorNode)},
+    {"FunctionInvocationNode", sizeof(FunctionInvocationNode)},
+    {"VariableReferenceNode", sizeof(VariableReferenceNode)},
+    {"AssignmentNode", sizeof(AssignmentNode)},
+    {"ReadNode", sizeof(ReadNode)},
+    {"IfNode", sizeof(IfNode)},
+    {"WhileNode", sizeof(WhileNode)},
+    {"ForNode", sizeof(ForNode)},
+    {"ReturnNode", sizeof(ReturnNode)},
+};
+static_assert(sizeof(kClasses) / sizeof(kClasses[0]) == kNumOfAstNodeKinds,
+              "a class of AstNodeKind is missing");
+
+double getRatio(const size_t p_numerator, const size_t p_denominator) {
+    return p_denominator != 0 ? static_cast<double>(p_numerator) / p_denominator
+                              : 0.0;
+}
+
+} // namespace
+
+void AstStats::preVisit(ConstantValueNode &p_constant_value) {
+    if (&p_constant_value == m_last_constant_value) {
+        return;
+    }
+    m_last_constant_value = &p_constant_value;
+    add(ConstantValueNode::kKind, p_constant_value.getNumOfOwnedBytes());
+}
+
+void AstStats::report(FILE *const p_output,
+                      const size_t p_num_of_lines) const {
+    size_t num_of_nodes = 0;
+    size_t num_of_bytes = 0;
+    for (size_t kind = 0; kind < kNumOfAstNodeKinds; ++kind) {
+        num_of_nodes += m_classes[kind].num_of_nodes;
+        num_of_bytes += m_classes[kind].num_of_nodes * kClasses[kind].size +
+                        m_classes[kind].num_of_owned_bytes;
+    }
+
+    fprintf(p_output, "%-24s %10s %7s %12s %12s %12s %6s\n", "class", "count",
+            "sizeof", "node bytes", "owned bytes", "total bytes", "share");
+    for (size_t kind = 0; kind < kNumOfAstNodeKinds; ++kind) {
+        const ClassStats &stats = m_classes[kind];
+        const size_t node_bytes = stats.num_of_nodes * kClasses[kind].size;
+        const size_t total_bytes = node_bytes + stats.num_of_owned_bytes;
+        fprintf(p_output, "%-24s %10zu %7zu %12zu %12zu %12zu %5.1f%%\n",
+                kClasses[kind].name, stats.num_of_nodes, kClasses[kind].size,
+                node_bytes, stats.num_of_owned_bytes, total_bytes,
+                100.0 * getRatio(total_bytes, num_of_bytes));
+    }
+
+    const size_t arena_bytes = Arena::getInstance().getNumOfBytes();
+    fprintf(p_output,
+            "AST of %zu nodes: %zu bytes (%.1f per node), %.1f bytes per "
+            "line of %zu; %zu bytes in the arena (%.1f per line)\n",
+            num_of_nodes, num_of_bytes, getRatio(num_of_bytes, num_of_nodes),
+            getRatio(num_of_bytes, p_num_of_lines), p_num_of_lines,
+            arena_bytes, getRatio(arena_bytes, p_num_of_lines));
+}
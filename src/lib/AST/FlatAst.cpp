@@ -0,0 +1,561 @@
+#include "AST/FlatAst.hpp"
+#include "AST/BinaryOperator.hpp"
+#include "AST/CompoundStatement.hpp"
+#include "AST/ConstantValue.hpp"
+#include "AST/FunctionInvocation.hpp"
+#include "AST/UnaryOperator.hpp"
+#include "AST/VariableReference.hpp"
+#include "AST/assignment.hpp"
+#include "AST/decl.hpp"
+#include "AST/for.hpp"
+#include "AST/function.hpp"
+#include "AST/if.hpp"
+#include "AST/print.hpp"
+#include "AST/program.hpp"
+#include "AST/read.hpp"
+#include "AST/return.hpp"
+#include "AST/variable.hpp"
+#include "AST/while.hpp"
+#include "visitor/AstWalker.hpp"
+#include "visitor/FlatAstVisitor.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+
+// Walks the AST in the order of AstNode::visitChildNodes() and appends each
+// node to the array of its kind before its children, so that the arrays
+// are in the order of a traversal. The ids of the children of the nodes
+// being walked are collected on a stack, from which a node takes them once
+// they have all been walked.
+class FlatAstBuilder final : public AstWalker<FlatAstBuilder> {
+  private:
+    using NodeId = FlatAst::NodeId;
+    using NodeList = FlatAst::NodeList;
+
+    // the struct of FlatAst for a class of AstNode
+    template <typename Node>
+    using FlatNode = typename std::tuple_element_t<
+        static_cast<size_t>(Node::kKind),
+        decltype(FlatAst::m_nodes)>::value_type;
+
+    // a node being walked, and where its children start on m_children
+    struct Frame {
+        NodeId id;
+        size_t first;
+    };
+
+    FlatAst &m_ast;
+    std::vector<Frame> m_frames;
+    std::vector<NodeId> m_children;
+    std::unordered_map<std::string, FlatAst::StringId> m_string_ids;
+    // the variables of a declaration share its constant
+    const ConstantValueNode *m_last_constant = nullptr;
+    NodeId m_last_constant_id = FlatAst::kNoNode;
+
+  public:
+    ~FlatAstBuilder() = default;
+    explicit FlatAstBuilder(FlatAst &p_ast) : m_ast(p_ast) {}
+
+    NodeId build(AstNode &p_root) {
+        walk(p_root);
+        return m_children.back();
+    }
+
+    // adds the node; postVisit() fills it in from its children
+    template <typename Node> void preVisit(Node &p_node) {
+        m_frames.push_back({add<FlatNode<Node>>(p_node), m_children.size()});
+    }
+    // not under each variable of the declaration again
+    void preVisit(ConstantValueNode &p_constant_value);
+
+    // ConstantValueNode: done in preVisit()
+    using AstWalker<FlatAstBuilder>::postVisit;
+
+    void postVisit(ProgramNode &p_program);
+    void postVisit(DeclNode &p_decl);
+    void postVisit(VariableNode &p_variable);
+    void postVisit(FunctionNode &p_function);
+    void postVisit(CompoundStatementNode &p_compound_statement);
+    void postVisit(PrintNode &p_print);
+    void postVisit(BinaryOperatorNode &p_bin_op);
+    void postVisit(UnaryOperatorNode &p_un_op);
+    void postVisit(FunctionInvocationNode &p_func_invocation);
+    void postVisit(VariableReferenceNode &p_variable_ref);
+    void postVisit(AssignmentNode &p_assignment);
+    void postVisit(ReadNode &p_read);
+    void postVisit(IfNode &p_if);
+    void postVisit(WhileNode &p_while);
+    void postVisit(ForNode &p_for);
+    void postVisit(ReturnNode &p_return);
+
+  private:
+    template <typename Node> NodeId add(const AstNode &p_node) {
+        auto &nodes = std::get<std::vector<Node>>(m_ast.m_nodes);
+        if (nodes.size() > FlatAst::getIndex(FlatAst::kNoNode)) {
+            throw std::length_error("too many AST nodes for a FlatAst");
+        }
+        const auto kind = static_cast<uint32_t>(Node::kKind);
+        const NodeId id = (kind << FlatAst::kIndexBits) | nodes.size();
+        nodes.push_back(Node{});
+        m_ast.m_locations[kind].push_back(p_node.getLocation());
+        return id;
+    }
+
+    // not kept across add(), which may move the array
+    template <typename Node> Node &at(const NodeId p_id) {
+        return std::get<std::vector<Node>>(m_ast.m_nodes)[FlatAst::getIndex(
+            p_id)];
+    }
+
+    Frame popFrame() {
+        const Frame frame = m_frames.back();
+        m_frames.pop_back();
+        return frame;
+    }
+
+    // the child at p_position from p_first, or kNoNode
+    NodeId getChild(const size_t p_first, const size_t p_position) const {
+        const size_t position = p_first + p_position;
+        return position < m_children.size() ? m_children[position]
+                                            : FlatAst::kNoNode;
+    }
+
+    // the children from p_first on that are of p_kind, which precede the
+    // others
+    NodeList takeList(size_t &p_first, const FlatAst::Kind p_kind) {
+        const auto first = static_cast<uint32_t>(m_ast.m_lists.size());
+        for (; p_first < m_children.size() &&
+               FlatAst::getKind(m_children[p_first]) == p_kind;
+             ++p_first) {
+            m_ast.m_lists.push_back(m_children[p_first]);
+        }
+        return {first, static_cast<uint32_t>(m_ast.m_lists.size() - first)};
+    }
+
+    NodeList takeAll(size_t p_first) {
+        const auto first = static_cast<uint32_t>(m_ast.m_lists.size());
+        m_ast.m_lists.insert(m_ast.m_lists.end(),
+                             m_children.begin() + p_first, m_children.end());
+        return {first, static_cast<uint32_t>(m_ast.m_lists.size() - first)};
+    }
+
+    // replaces the children of the node with the node
+    void finish(const size_t p_first, const NodeId p_id) {
+        m_children.resize(p_first);
+        m_children.push_back(p_id);
+    }
+
+    FlatAst::StringId addString(const char *const p_string) {
+        const auto result = m_string_ids.emplace(
+            p_string, static_cast<FlatAst::StringId>(m_ast.m_strings.size()));
+        if (result.second) {
+            m_ast.m_strings.append(p_string).push_back('\0');
+        }
+        return result.first->second;
+    }
+};
+
+void FlatAstBuilder::postVisit(ProgramNode &p_program) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    size_t first = frame.first;
+    const size_t children = first;
+
+    auto &program = at<FlatAst::Program>(id);
+    program.name = p_program.getName();
+    program.decls = takeList(first, FlatAst::Kind::kDecl);
+    program.functions = takeList(first, FlatAst::Kind::kFunction);
+    program.body = getChild(first, 0);
+    finish(children, id);
+}
+
+void FlatAstBuilder::postVisit(DeclNode &p_decl) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    at<FlatAst::Decl>(id).variables = takeAll(first);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(VariableNode &p_variable) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    auto &variable = at<FlatAst::Variable>(id);
+    variable.name = p_variable.getName();
+    variable.type = p_variable.getType();
+    variable.constant = getChild(first, 0);
+    finish(first, id);
+}
+
+void FlatAstBuilder::preVisit(ConstantValueNode &p_constant_value) {
+    if (&p_constant_value != m_last_constant) {
+        m_last_constant = &p_constant_value;
+        m_last_constant_id = add<FlatAst::ConstantValue>(p_constant_value);
+
+        auto &constant = at<FlatAst::ConstantValue>(m_last_constant_id);
+        constant.value =
+            addString(p_constant_value.getConstantValueCString());
+        constant.type = p_constant_value.getType();
+    }
+    m_children.push_back(m_last_constant_id);
+}
+
+void FlatAstBuilder::postVisit(FunctionNode &p_function) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    size_t first = frame.first;
+    const size_t children = first;
+
+    auto &function = at<FlatAst::Function>(id);
+    function.name = p_function.getName();
+    function.prototype = addString(p_function.getPrototypeCString());
+    function.parameters = takeList(first, FlatAst::Kind::kDecl);
+    function.body = getChild(first, 0);
+    finish(children, id);
+}
+
+void FlatAstBuilder::postVisit(CompoundStatementNode &p_compound_statement) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    size_t first = frame.first;
+    const size_t children = first;
+
+    auto &compound_statement = at<FlatAst::CompoundStatement>(id);
+    compound_statement.decls = takeList(first, FlatAst::Kind::kDecl);
+    compound_statement.statements = takeAll(first);
+    finish(children, id);
+}
+
+void FlatAstBuilder::postVisit(PrintNode &p_print) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    at<FlatAst::Print>(id).target = getChild(first, 0);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(BinaryOperatorNode &p_bin_op) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    auto &bin_op = at<FlatAst::BinaryOperator>(id);
+    bin_op.op = p_bin_op.getOp();
+    bin_op.left_operand = getChild(first, 0);
+    bin_op.right_operand = getChild(first, 1);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(UnaryOperatorNode &p_un_op) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    auto &un_op = at<FlatAst::UnaryOperator>(id);
+    un_op.op = p_un_op.getOp();
+    un_op.operand = getChild(first, 0);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(FunctionInvocationNode &p_func_invocation) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    auto &func_invocation = at<FlatAst::FunctionInvocation>(id);
+    func_invocation.name = p_func_invocation.getName();
+    func_invocation.arguments = takeAll(first);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(VariableReferenceNode &p_variable_ref) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    auto &variable_ref = at<FlatAst::VariableReference>(id);
+    variable_ref.name = p_variable_ref.getName();
+    variable_ref.indices = takeAll(first);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(AssignmentNode &p_assignment) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    auto &assignment = at<FlatAst::Assignment>(id);
+    assignment.lvalue = getChild(first, 0);
+    assignment.expr = getChild(first, 1);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(ReadNode &p_read) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    at<FlatAst::Read>(id).target = getChild(first, 0);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(IfNode &p_if) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    auto &if_node = at<FlatAst::If>(id);
+    if_node.condition = getChild(first, 0);
+    if_node.body = getChild(first, 1);
+    if_node.else_body = getChild(first, 2);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(WhileNode &p_while) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    auto &while_node = at<FlatAst::While>(id);
+    while_node.condition = getChild(first, 0);
+    while_node.body = getChild(first, 1);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(ForNode &p_for) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    auto &for_node = at<FlatAst::For>(id);
+    for_node.loop_var_decl = getChild(first, 0);
+    for_node.init_stmt = getChild(first, 1);
+    for_node.end_condition = getChild(first, 2);
+    for_node.body = getChild(first, 3);
+    finish(first, id);
+}
+
+void FlatAstBuilder::postVisit(ReturnNode &p_return) {
+    const Frame frame = popFrame();
+    const NodeId id = frame.id;
+    const size_t first = frame.first;
+
+    at<FlatAst::Return>(id).ret_val = getChild(first, 0);
+    finish(first, id);
+}
+
+FlatAst::FlatAst(AstNode &p_root) {
+    FlatAstBuilder builder(*this);
+    m_root = builder.build(p_root);
+
+    std::apply([](auto &...nodes) { (nodes.shrink_to_fit(), ...); },
+               m_nodes);
+    for (auto &locations : m_locations) {
+        locations.shrink_to_fit();
+    }
+    m_lists.shrink_to_fit();
+    m_strings.shrink_to_fit();
+}
+
+void FlatAst::accept(const NodeId p_id, FlatAstVisitor &p_visitor) const {
+    switch (getKind(p_id)) {
+    case Kind::kProgram:
+        p_visitor.visit(p_id, get<Program>(p_id));
+        break;
+    case Kind::kDecl:
+        p_visitor.visit(p_id, get<Decl>(p_id));
+        break;
+    case Kind::kVariable:
+        p_visitor.visit(p_id, get<Variable>(p_id));
+        break;
+    case Kind::kConstantValue:
+        p_visitor.visit(p_id, get<ConstantValue>(p_id));
+        break;
+    case Kind::kFunction:
+        p_visitor.visit(p_id, get<Function>(p_id));
+        break;
+    case Kind::kCompoundStatement:
+        p_visitor.visit(p_id, get<CompoundStatement>(p_id));
+        break;
+    case Kind::kPrint:
+        p_visitor.visit(p_id, get<Print>(p_id));
+        break;
+    case Kind::kBinaryOperator:
+        p_visitor.visit(p_id, get<BinaryOperator>(p_id));
+        break;
+    case Kind::kUnaryOperator:
+        p_visitor.visit(p_id, get<UnaryOperator>(p_id));
+        break;
+    case Kind::kFunctionInvocation:
+        p_visitor.visit(p_id, get<FunctionInvocation>(p_id));
+        break;
+    case Kind::kVariableReference:
+        p_visitor.visit(p_id, get<VariableReference>(p_id));
+        break;
+    case Kind::kAssignment:
+        p_visitor.visit(p_id, get<Assignment>(p_id));
+        break;
+    case Kind::kRead:
+        p_visitor.visit(p_id, get<Read>(p_id));
+        break;
+    case Kind::kIf:
+        p_visitor.visit(p_id, get<If>(p_id));
+        break;
+    case Kind::kWhile:
+        p_visitor.visit(p_id, get<While>(p_id));
+        break;
+    case Kind::kFor:
+        p_visitor.visit(p_id, get<For>(p_id));
+        break;
+    case Kind::kReturn:
+        p_visitor.visit(p_id, get<Return>(p_id));
+        break;
+    }
+}
+
+void FlatAst::walk(const NodeId p_root, FlatAstVisitor &p_visitor) const {
+    // a node whose visit() is next or, with kLeave set, whose leave() is
+    constexpr uint64_t kLeave = uint64_t{1} << 32;
+    std::vector<uint64_t> stack{p_root};
+    while (!stack.empty()) {
+        const uint64_t frame = stack.back();
+        stack.pop_back();
+        const auto id = static_cast<NodeId>(frame);
+        if (frame & kLeave) {
+            p_visitor.leave(id);
+            continue;
+        }
+        accept(id, p_visitor);
+        stack.push_back(frame | kLeave);
+        // the first child on top
+        const size_t first = stack.size();
+        forEachChild(id, [&stack](const NodeId p_child) {
+            stack.push_back(p_child);
+        });
+        std::reverse(stack.begin() + first, stack.end());
+    }
+}
+
+template <typename Callback>
+void FlatAst::forEachChild(const NodeId p_id, Callback &&p_callback) const {
+    auto visit_node = [&](const NodeId child) {
+        if (child != kNoNode) {
+            p_callback(child);
+        }
+    };
+    auto visit_nodes = [&](const NodeList list) {
+        for (const NodeId child : getNodes(list)) {
+            p_callback(child);
+        }
+    };
+
+    switch (getKind(p_id)) {
+    case Kind::kProgram: {
+        const auto &program = get<Program>(p_id);
+        visit_nodes(program.decls);
+        visit_nodes(program.functions);
+        visit_node(program.body);
+        break;
+    }
+    case Kind::kDecl:
+        visit_nodes(get<Decl>(p_id).variables);
+        break;
+    case Kind::kVariable:
+        visit_node(get<Variable>(p_id).constant);
+        break;
+    case Kind::kConstantValue:
+        break;
+    case Kind::kFunction: {
+        const auto &function = get<Function>(p_id);
+        visit_nodes(function.parameters);
+        visit_node(function.body);
+        break;
+    }
+    case Kind::kCompoundStatement: {
+        const auto &compound_statement = get<CompoundStatement>(p_id);
+        visit_nodes(compound_statement.decls);
+        visit_nodes(compound_statement.statements);
+        break;
+    }
+    case Kind::kPrint:
+        visit_node(get<Print>(p_id).target);
+        break;
+    case Kind::kBinaryOperator: {
+        const auto &bin_op = get<BinaryOperator>(p_id);
+        visit_node(bin_op.left_operand);
+        visit_node(bin_op.right_operand);
+        break;
+    }
+    case Kind::kUnaryOperator:
+        visit_node(get<UnaryOperator>(p_id).operand);
+        break;
+    case Kind::kFunctionInvocation:
+        visit_nodes(get<FunctionInvocation>(p_id).arguments);
+        break;
+    case Kind::kVariableReference:
+        visit_nodes(get<VariableReference>(p_id).indices);
+        break;
+    case Kind::kAssignment: {
+        const auto &assignment = get<Assignment>(p_id);
+        visit_node(assignment.lvalue);
+        visit_node(assignment.expr);
+        break;
+    }
+    case Kind::kRead:
+        visit_node(get<Read>(p_id).target);
+        break;
+    case Kind::kIf: {
+        const auto &if_node = get<If>(p_id);
+        visit_node(if_node.condition);
+        visit_node(if_node.body);
+        visit_node(if_node.else_body);
+        break;
+    }
+    case Kind::kWhile: {
+        const auto &while_node = get<While>(p_id);
+        visit_node(while_node.condition);
+        visit_node(while_node.body);
+        break;
+    }
+    case Kind::kFor: {
+        const auto &for_node = get<For>(p_id);
+        visit_node(for_node.loop_var_decl);
+        visit_node(for_node.init_stmt);
+        visit_node(for_node.end_condition);
+        visit_node(for_node.body);
+        break;
+    }
+    case Kind::kReturn:
+        visit_node(get<Return>(p_id).ret_val);
+        break;
+    }
+}
+
+size_t FlatAst::getNumOfNodes() const {
+    size_t num_of_nodes = 0;
+    for (const auto &locations : m_locations) {
+        num_of_nodes += locations.size();
+    }
+    return num_of_nodes;
+}
+
+size_t FlatAst::getNumOfBytes() const {
+    size_t num_of_bytes = 0;
+    std::apply(
+        [&](const auto &...nodes) {
+            ((num_of_bytes += nodes.capacity() * sizeof(nodes[0])), ...);
+        },
+        m_nodes);
+    for (const auto &locations : m_locations) {
+        num_of_bytes += locations.capacity() * sizeof(Location);
+    }
+    num_of_bytes += m_lists.capacity() * sizeof(NodeId);
+    num_of_bytes += m_strings.capacity();
+    return num_of_bytes;
+}
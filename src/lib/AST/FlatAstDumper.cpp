@@ -0,0 +1,117 @@
+#include "AST/FlatAstDumper.hpp"
+
+#include <cstdio>
+
+void FlatAstDumper::outputNodeHeader(const char *const p_name,
+                                     const NodeId p_id) {
+    const Location &location = m_ast.getLocation(p_id);
+    std::fprintf(m_output, "%*s%s <line: %u, col: %u>", m_indentation, "",
+                 p_name, location.line, location.col);
+    m_indentation += m_indentation_stride;
+}
+
+void FlatAstDumper::leave(const NodeId) {
+    m_indentation -= m_indentation_stride;
+}
+
+void FlatAstDumper::visit(const NodeId p_id,
+                          const FlatAst::Program &p_program) {
+    outputNodeHeader("program", p_id);
+    std::fprintf(m_output, " %s %s\n", getAtomCString(p_program.name),
+                 "void");
+}
+
+void FlatAstDumper::visit(const NodeId p_id, const FlatAst::Decl &p_decl) {
+    outputNodeHeader("declaration", p_id);
+    std::fputc('\n', m_output);
+}
+
+void FlatAstDumper::visit(const NodeId p_id,
+                          const FlatAst::Variable &p_variable) {
+    outputNodeHeader("variable", p_id);
+    std::fprintf(m_output, " %s %s\n", getAtomCString(p_variable.name),
+                 getTypeCString(p_variable.type));
+}
+
+void FlatAstDumper::visit(const NodeId p_id,
+                          const FlatAst::ConstantValue &p_constant_value) {
+    outputNodeHeader("constant", p_id);
+    std::fprintf(m_output, " %s\n",
+                 m_ast.getCString(p_constant_value.value));
+}
+
+void FlatAstDumper::visit(const NodeId p_id,
+                          const FlatAst::Function &p_function) {
+    outputNodeHeader("function declaration", p_id);
+    std::fprintf(m_output, " %s %s\n", getAtomCString(p_function.name),
+                 m_ast.getCString(p_function.prototype));
+}
+
+void FlatAstDumper::visit(
+    const NodeId p_id, const FlatAst::CompoundStatement &p_compound_statement) {
+    outputNodeHeader("compound statement", p_id);
+    std::fputc('\n', m_output);
+}
+
+void FlatAstDumper::visit(const NodeId p_id, const FlatAst::Print &p_print) {
+    outputNodeHeader("print statement", p_id);
+    std::fputc('\n', m_output);
+}
+
+void FlatAstDumper::visit(const NodeId p_id,
+                          const FlatAst::BinaryOperator &p_bin_op) {
+    outputNodeHeader("binary operator", p_id);
+    std::fprintf(m_output, " %s\n",
+                 kOpString[static_cast<size_t>(p_bin_op.op)]);
+}
+
+void FlatAstDumper::visit(const NodeId p_id,
+                          const FlatAst::UnaryOperator &p_un_op) {
+    outputNodeHeader("unary operator", p_id);
+    std::fprintf(m_output, " %s\n",
+                 kOpString[static_cast<size_t>(p_un_op.op)]);
+}
+
+void FlatAstDumper::visit(
+    const NodeId p_id, const FlatAst::FunctionInvocation &p_func_invocation) {
+    outputNodeHeader("function invocation", p_id);
+    std::fprintf(m_output, " %s\n", getAtomCString(p_func_invocation.name));
+}
+
+void FlatAstDumper::visit(const NodeId p_id,
+                          const FlatAst::VariableReference &p_variable_ref) {
+    outputNodeHeader("variable reference", p_id);
+    std::fprintf(m_output, " %s\n", getAtomCString(p_variable_ref.name));
+}
+
+void FlatAstDumper::visit(const NodeId p_id,
+                          const FlatAst::Assignment &p_assignment) {
+    outputNodeHeader("assignment statement", p_id);
+    std::fputc('\n', m_output);
+}
+
+void FlatAstDumper::visit(const NodeId p_id, const FlatAst::Read &p_read) {
+    outputNodeHeader("read statement", p_id);
+    std::fputc('\n', m_output);
+}
+
+void FlatAstDumper::visit(const NodeId p_id, const FlatAst::If &p_if) {
+    outputNodeHeader("if statement", p_id);
+    std::fputc('\n', m_output);
+}
+
+void FlatAstDumper::visit(const NodeId p_id, const FlatAst::While &p_while) {
+    outputNodeHeader("while statement", p_id);
+    std::fputc('\n', m_output);
+}
+
+void FlatAstDumper::visit(const NodeId p_id, const FlatAst::For &p_for) {
+    outputNodeHeader("for statement", p_id);
+    std::fputc('\n', m_output);
+}
+
+void FlatAstDumper::visit(const NodeId p_id,
+                          const FlatAst::Return &p_return) {
+    outputNodeHeader("return statement", p_id);
+    std::fputc('\n', m_output);
+}
@@ -1,21 +1,54 @@
 #include "AST/PType.hpp"
 
+#include <string>
+#include <utility>
+
 const char *kTypeString[] = {"void", "integer", "real", "boolean", "string"};
 
-// logical constness
-const char *PType::getPTypeCString() const {
-    if (!m_type_string_is_valid) {
-        m_type_string += kTypeString[static_cast<size_t>(m_type)];
+TypeContext::TypeContext() {
+    m_types.emplace_back(new PType(PType::PrimitiveTypeEnum::kVoidType, {},
+                                   kNoType, kNoType, "")); // kNoType
+    for (const auto type :
+         {PType::PrimitiveTypeEnum::kVoidType,
+          PType::PrimitiveTypeEnum::kIntegerType,
+          PType::PrimitiveTypeEnum::kRealType,
+          PType::PrimitiveTypeEnum::kBoolType,
+          PType::PrimitiveTypeEnum::kStringType}) {
+        m_types.emplace_back(new PType(type, {}, getPrimitiveType(type),
+                                       kNoType,
+                                       kTypeString[static_cast<size_t>(type)]));
+    }
+}
 
-        if (m_dimensions.size() != 0) {
-            m_type_string += " ";
+TypeId TypeContext::intern(const PType::PrimitiveTypeEnum p_type,
+                           const uint64_t *const p_dimensions,
+                           const size_t p_num_of_dimensions) {
+    if (p_num_of_dimensions == 0) {
+        return getPrimitiveType(p_type);
+    }
 
-            for (const auto &dim : m_dimensions) {
-                m_type_string += "[" + std::to_string(dim) + "]";
-            }
-        }
-        m_type_string_is_valid = true;
+    std::string type_string = kTypeString[static_cast<size_t>(p_type)];
+    type_string += " ";
+    for (size_t i = 0; i < p_num_of_dimensions; ++i) {
+        type_string += "[" + std::to_string(p_dimensions[i]) + "]";
+    }
+    const auto found = m_array_types.find(type_string);
+    if (found != m_array_types.end()) {
+        return found->second;
     }
 
-    return m_type_string.c_str();
+    const TypeId sub_array_type =
+        intern(p_type, p_dimensions + 1, p_num_of_dimensions - 1);
+    const auto id = static_cast<TypeId>(m_types.size());
+    const size_t type_string_size = type_string.size();
+    m_types.emplace_back(new PType(
+        p_type,
+        std::vector<uint64_t>(p_dimensions,
+                              p_dimensions + p_num_of_dimensions),
+        getPrimitiveType(p_type), sub_array_type, std::move(type_string)));
+    // key the map with the string of the type, which does not move
+    m_array_types.emplace(
+        std::string_view(m_types.back()->getPTypeCString(), type_string_size),
+        id);
+    return id;
 }
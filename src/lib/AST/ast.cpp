@@ -1,9 +1,7 @@
 #include <AST/ast.hpp>
 
-// prevent the linker from complaining
-AstNode::~AstNode() {}
-
-AstNode::AstNode(const uint32_t line, const uint32_t col)
-    : location(line, col) {}
+AstNode::AstNode(const AstNodeKind p_kind, const uint32_t line,
+                 const uint32_t col)
+    : location(line, col), m_kind(p_kind) {}
 
 const Location &AstNode::getLocation() const { return location; }
@@ -1,28 +1,23 @@
 #include "AST/constant.hpp"
+#include "util/Arena.hpp"
+
+#include <string>
 
 static const char *kTFString[] = {"false", "true"};
 
-// logical constness
-const char *Constant::getConstantValueCString() const {
-    if (!m_constant_value_string_is_valid) {
-        switch (m_type->getPrimitiveType()) {
-        case PType::PrimitiveTypeEnum::kIntegerType:
-            m_constant_value_string = std::to_string(m_value.integer);
-            break;
-        case PType::PrimitiveTypeEnum::kRealType:
-            m_constant_value_string = std::to_string(m_value.real);
-            break;
-        case PType::PrimitiveTypeEnum::kBoolType:
-            m_constant_value_string = kTFString[m_value.boolean];
-            break;
-        case PType::PrimitiveTypeEnum::kStringType:
-            m_constant_value_string = m_value.string;
-            break;
-        case PType::PrimitiveTypeEnum::kVoidType:
-        default:
-            break;
-        }
-        m_constant_value_string_is_valid = true;
+const char *Constant::makeConstantValueCString(const TypeId p_type,
+                                               const ConstantValue p_value) {
+    switch (getPType(p_type).getPrimitiveType()) {
+    case PType::PrimitiveTypeEnum::kIntegerType:
+        return Arena::getInstance().copyString(std::to_string(p_value.integer));
+    case PType::PrimitiveTypeEnum::kRealType:
+        return Arena::getInstance().copyString(std::to_string(p_value.real));
+    case PType::PrimitiveTypeEnum::kBoolType:
+        return kTFString[p_value.boolean];
+    case PType::PrimitiveTypeEnum::kStringType:
+        return nullptr;
+    case PType::PrimitiveTypeEnum::kVoidType:
+    default:
+        return "";
     }
-    return m_constant_value_string.c_str();
 }
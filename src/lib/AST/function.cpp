@@ -1,7 +1,8 @@
 #include "AST/function.hpp"
 #include "AST/decl.hpp"
 
-#include <algorithm>
+#include <cstring>
+#include <string>
 
 static std::string
 getParametersTypeString(const FunctionNode::DeclNodes &p_parameters) {
@@ -21,26 +22,35 @@ getParametersTypeString(const FunctionNode::DeclNodes &p_parameters) {
     return type_string;
 }
 
-const char *FunctionNode::getPrototypeCString() const {
-    if (!m_prototype_string_is_valid) {
-        m_prototype_string = m_ret_type->getPTypeCString();
+const char *
+FunctionNode::makePrototypeCString(const TypeId p_ret_type,
+                                   const DeclNodes &p_parameters) {
+    std::string prototype_string = getTypeCString(p_ret_type);
 
-        m_prototype_string += " (";
-        m_prototype_string += getParametersTypeString(m_parameters);
-        m_prototype_string += ")";
+    prototype_string += " (";
+    prototype_string += getParametersTypeString(p_parameters);
+    prototype_string += ")";
 
-        m_prototype_string_is_valid = true;
+    return Arena::getInstance().copyString(prototype_string);
+}
+
+size_t FunctionNode::getNumOfOwnedBytes() const {
+    size_t num_of_bytes =
+        m_parameters.getNumOfArenaBytes() + std::strlen(m_prototype_string) + 1;
+    if (m_lazy_body != nullptr) {
+        num_of_bytes += sizeof(LazyFunctionBody);
     }
+    return num_of_bytes;
+}
 
-    return m_prototype_string.c_str();
+CompoundStatementNode *FunctionNode::getBody() {
+    if (m_lazy_body != nullptr) {
+        m_body = parseFunctionBody(*m_lazy_body);
+        m_lazy_body = nullptr;
+    }
+    return m_body;
 }
 
 void FunctionNode::visitChildNodes(AstNodeVisitor &p_visitor) {
-    auto visit_ast_node = [&](auto &ast_node) { ast_node->accept(p_visitor); };
-
-    for_each(m_parameters.begin(), m_parameters.end(), visit_ast_node);
-
-    if (m_body) {
-        visit_ast_node(m_body);
-    }
+    forEachChild([&](AstNode &p_child) { p_child.accept(p_visitor); });
 }
@@ -1,5 +1,5 @@
 #include "AST/read.hpp"
 
 void ReadNode::visitChildNodes(AstNodeVisitor &p_visitor) {
-    m_target->accept(p_visitor);
+    forEachChild([&](AstNode &p_child) { p_child.accept(p_visitor); });
 }
@@ -1,5 +1,5 @@
 #include "AST/return.hpp"
 
 void ReturnNode::visitChildNodes(AstNodeVisitor &p_visitor) {
-    m_ret_val->accept(p_visitor);
+    forEachChild([&](AstNode &p_child) { p_child.accept(p_visitor); });
 }
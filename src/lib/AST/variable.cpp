@@ -1,7 +1,5 @@
 #include "AST/variable.hpp"
 
 void VariableNode::visitChildNodes(AstNodeVisitor &p_visitor) {
-    if (m_constant_value_node_ptr) {
-        m_constant_value_node_ptr->accept(p_visitor);
-    }
+    forEachChild([&](AstNode &p_child) { p_child.accept(p_visitor); });
 }
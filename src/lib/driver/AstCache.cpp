@@ -0,0 +1,222 @@
+#include "driver/AstCache.hpp"
+
+#include "AST/AstFile.hpp"
+#include "AST/program.hpp"
+#include "util/Arena.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// set by the Makefile
+#ifndef COMPILER_VERSION
+#define COMPILER_VERSION "unknown"
+#endif
+
+namespace {
+
+constexpr char kMagic[8] = {'P', 'A', 'S', 'T', 'C', 'A', 'C', 'H'};
+// raise when the layout of an entry or of AST/AstFile.hpp changes
+constexpr uint32_t kFormatVersion = 2;
+
+constexpr uint32_t kDumpSymbolTableFlag = 1;
+
+// at the start of an entry; then come the source and the listing, each
+// padded to a whole word, and the words of the AST
+struct EntryHeader {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t flags;
+    uint64_t key;
+    uint64_t source_size;
+    uint64_t listing_size;
+    uint64_t num_of_ast_words;
+    // of the listing and the AST, so that a damaged entry is a miss rather
+    // than a program that no parse would have built
+    uint64_t payload_hash;
+};
+
+size_t roundUpToWord(const size_t p_size) { return (p_size + 3) & ~size_t{3}; }
+
+// A 64-bit hash, a word at a time. It is not meant to withstand crafted
+// collisions; an entry also holds its source, which a hit has to match.
+uint64_t hashBytes(uint64_t p_hash, const char *const p_data,
+                   const size_t p_size) {
+    constexpr uint64_t kMultiplier = 0x9e3779b97f4a7c15;
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= p_size; offset += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, p_data + offset, sizeof(word));
+        p_hash = (p_hash ^ word) * kMultiplier;
+        p_hash ^= p_hash >> 29;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, p_data + offset, p_size - offset);
+    p_hash = (p_hash ^ tail ^ p_size) * kMultiplier;
+    return p_hash ^ (p_hash >> 32);
+}
+
+// What tells this compiler from others: the version it was built as, and
+// the size and modification time of the executable, which change with each
+// build even when the version does not.
+const std::string &getCompilerId() {
+    static const std::string id = [] {
+        std::string compiler_id = COMPILER_VERSION;
+        compiler_id += ' ';
+        compiler_id += std::to_string(kFormatVersion);
+        struct stat executable;
+        if (stat("/proc/self/exe", &executable) == 0) {
+            compiler_id += ' ';
+            compiler_id += std::to_string(executable.st_size);
+            compiler_id += ' ';
+            compiler_id += std::to_string(executable.st_mtime);
+        }
+        return compiler_id;
+    }();
+    return id;
+}
+
+// Creates a file of its own next to p_path to write an entry in, for all
+// who may read the directory as the umask allows. A name another process
+// left behind is passed over.
+int createTemporaryFile(const std::string &p_path,
+                        std::string &p_temporary_path) {
+    // tells apart the files of the threads of one process
+    static std::atomic<uint32_t> next_number{0};
+    constexpr int kMaxAttempts = 16;
+    for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+        p_temporary_path = p_path + '.' + std::to_string(getpid()) + '.' +
+                           std::to_string(next_number++);
+        const int fd = open(p_temporary_path.c_str(),
+                            O_CREAT | O_EXCL | O_WRONLY, 0666);
+        if (fd >= 0 || errno != EEXIST) {
+            return fd;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+uint64_t AstCache::getKey(const SourceBuffer &p_source) const {
+    const std::string &compiler_id = getCompilerId();
+    const uint64_t hash =
+        hashBytes(0, compiler_id.data(), compiler_id.size());
+    return hashBytes(hash, p_source.getData(), p_source.getSize());
+}
+
+std::string AstCache::getPath(const uint64_t p_key) const {
+    char name[32];
+    snprintf(name, sizeof(name), "/%016" PRIx64 ".ast", p_key);
+    return m_directory + name;
+}
+
+ProgramNode *AstCache::load(const SourceBuffer &p_source, FILE *const p_output,
+                            bool &p_dump_symbol_table) const {
+    const uint64_t key = getKey(p_source);
+    SourceBuffer entry;
+    if (!entry.open(getPath(key).c_str(), true) ||
+        entry.getSize() < sizeof(EntryHeader)) {
+        return nullptr;
+    }
+
+    EntryHeader header;
+    std::memcpy(&header, entry.getData(), sizeof(header));
+    const size_t source_size = roundUpToWord(p_source.getSize());
+    if (entry.getSize() - sizeof(header) < source_size) {
+        return nullptr;
+    }
+    const size_t size = entry.getSize() - sizeof(header) - source_size;
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.format_version != kFormatVersion || header.key != key ||
+        header.source_size != p_source.getSize() ||
+        header.listing_size > size ||
+        header.num_of_ast_words > size / sizeof(uint32_t) ||
+        roundUpToWord(header.listing_size) +
+                header.num_of_ast_words * sizeof(uint32_t) !=
+            size) {
+        return nullptr;
+    }
+
+    // the key only tells sources apart by chance, so the source decides
+    const char *const source = entry.getData() + sizeof(header);
+    if (std::memcmp(source, p_source.getData(), p_source.getSize()) != 0) {
+        return nullptr;
+    }
+    const char *const listing = source + source_size;
+    if (hashBytes(0, listing, size) != header.payload_hash) {
+        return nullptr;
+    }
+    // the mapping is page-aligned and the header a whole number of words
+    const auto *const words = reinterpret_cast<const uint32_t *>(
+        listing + roundUpToWord(header.listing_size));
+    const Arena::Mark mark = Arena::getInstance().getMark();
+    ProgramNode *const program = readAst(words, header.num_of_ast_words);
+    if (program == nullptr) {
+        Arena::getInstance().rewind(mark);
+        return nullptr;
+    }
+
+    if (p_output != nullptr) {
+        fwrite(listing, 1, header.listing_size, p_output);
+    }
+    p_dump_symbol_table = (header.flags & kDumpSymbolTableFlag) != 0;
+    return program;
+}
+
+bool AstCache::store(const SourceBuffer &p_source, ProgramNode &p_program,
+                     const std::string_view p_listing,
+                     const bool p_dump_symbol_table) const {
+    std::vector<uint32_t> words;
+    writeAst(p_program, words);
+
+    EntryHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.format_version = kFormatVersion;
+    header.flags = p_dump_symbol_table ? kDumpSymbolTableFlag : 0;
+    header.key = getKey(p_source);
+    header.source_size = p_source.getSize();
+    header.listing_size = p_listing.size();
+    header.num_of_ast_words = words.size();
+    const size_t padding = roundUpToWord(p_listing.size()) - p_listing.size();
+    std::string payload(p_listing);
+    payload.append(padding, '\0');
+    payload.append(reinterpret_cast<const char *>(words.data()),
+                   words.size() * sizeof(uint32_t));
+    header.payload_hash = hashBytes(0, payload.data(), payload.size());
+    std::string source(p_source.getData(), p_source.getSize());
+    source.append(roundUpToWord(source.size()) - source.size(), '\0');
+
+    if (mkdir(m_directory.c_str(), 0777) != 0 && errno != EEXIST) {
+        return false;
+    }
+    const std::string path = getPath(header.key);
+    std::string temporary_path;
+    const int fd = createTemporaryFile(path, temporary_path);
+    if (fd < 0) {
+        return false;
+    }
+    FILE *const file = fdopen(fd, "wb");
+    if (file == nullptr) {
+        close(fd);
+        unlink(temporary_path.c_str());
+        return false;
+    }
+
+    bool is_written =
+        fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(source.data(), 1, source.size(), file) == source.size() &&
+        fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+    is_written = (fclose(file) == 0) && is_written;
+    if (!is_written || rename(temporary_path.c_str(), path.c_str()) != 0) {
+        unlink(temporary_path.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,606 @@
+#include "driver/Compiler.hpp"
+
+#include "AST/AstDumper.hpp"
+#include "AST/AstFile.hpp"
+#include "AST/AstJsonDumper.hpp"
+#include "AST/AstStats.hpp"
+#include "AST/CompoundStatement.hpp"
+#include "AST/FlatAst.hpp"
+#include "AST/FlatAstDumper.hpp"
+#include "AST/program.hpp"
+#include "driver/AstCache.hpp"
+#include "driver/CompilationContext.hpp"
+#include "sema/SemanticAnalyzer.hpp"
+#include "util/LineIndex.hpp"
+#include "visitor/AstNodeInclude.hpp"
+#include "visitor/AstNodeVisitor.hpp"
+#include "visitor/AstStaticVisitor.hpp"
+#include "visitor/AstWalker.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// The stream the caller asked for, or one that collects into a string.
+class OutputStream {
+  private:
+    FILE *m_file;
+    char *m_data = nullptr;
+    size_t m_size = 0;
+    bool m_is_collecting;
+
+  public:
+    ~OutputStream() {
+        if (m_is_collecting) {
+            std::fclose(m_file);
+            std::free(m_data);
+        }
+    }
+    explicit OutputStream(FILE *const p_file)
+        : m_file(p_file), m_is_collecting(p_file == nullptr) {
+        if (m_is_collecting) {
+            m_file = open_memstream(&m_data, &m_size);
+            if (m_file == nullptr) {
+                throw std::bad_alloc();
+            }
+        }
+    }
+
+    OutputStream(const OutputStream &) = delete;
+    OutputStream &operator=(const OutputStream &) = delete;
+
+    FILE *get() const { return m_file; }
+
+    // ends the stream; what it collected, if anything, goes to p_string
+    void finish(std::string &p_string) {
+        if (!m_is_collecting) {
+            return;
+        }
+        std::fclose(m_file);
+        p_string.assign(m_data, m_size);
+        std::free(m_data);
+        m_data = nullptr;
+        m_is_collecting = false;
+    }
+};
+
+// An anonymous file on disk, so that what waits in it does not take memory.
+class TemporaryFile {
+  private:
+    FILE *m_file;
+
+  public:
+    ~TemporaryFile() { std::fclose(m_file); }
+    TemporaryFile() : m_file(std::tmpfile()) {
+        if (m_file == nullptr) {
+            throw std::system_error(errno, std::generic_category(),
+                                    "tmpfile() failed");
+        }
+    }
+
+    TemporaryFile(const TemporaryFile &) = delete;
+    TemporaryFile &operator=(const TemporaryFile &) = delete;
+
+    FILE *get() const { return m_file; }
+
+    void copyTo(FILE *const p_file) {
+        std::rewind(m_file);
+        char buffer[BUFSIZ];
+        size_t size;
+        while ((size = std::fread(buffer, 1, sizeof(buffer), m_file)) != 0) {
+            std::fwrite(buffer, 1, size, p_file);
+        }
+    }
+};
+
+void startLexer(CompilationContext &p_context,
+                const CompileOptions &p_options) {
+    SourceBuffer &source = p_context.source;
+    switch (p_options.lexer) {
+    case LexerKind::kFast:
+        p_context.fast_lexer.reset(
+            new FastLexer(source.getData(), source.getSize()));
+        break;
+    case LexerKind::kThreaded:
+        p_context.threaded_lexer.reset(
+            new ThreadedLexer(source.getData(), source.getSize()));
+        break;
+    case LexerKind::kParallel:
+        p_context.parallel_lexer.reset(new ParallelLexer(
+            source.getData(), source.getSize(), p_options.num_of_lexer_threads));
+        break;
+    case LexerKind::kFlex:
+        p_context.flex_scanner =
+            createFlexScanner(source, p_context.flex_state, p_context.output);
+        if (p_context.flex_scanner == nullptr) {
+            throw std::bad_alloc();
+        }
+        break;
+    }
+}
+
+// Counts the nodes of a tree, dispatched through virtual calls.
+class VirtualNodeCounter final : public AstNodeVisitor {
+  private:
+    size_t m_num_of_nodes = 0;
+
+    void count(AstNode &p_node) {
+        ++m_num_of_nodes;
+        p_node.visitChildNodes(*this);
+    }
+
+  public:
+    size_t getNumOfNodes() const { return m_num_of_nodes; }
+
+    void visit(ProgramNode &p_program) override { count(p_program); }
+    void visit(DeclNode &p_decl) override { count(p_decl); }
+    void visit(VariableNode &p_variable) override { count(p_variable); }
+    void visit(ConstantValueNode &p_constant_value) override {
+        count(p_constant_value);
+    }
+    void visit(FunctionNode &p_function) override { count(p_function); }
+    void visit(CompoundStatementNode &p_compound_statement) override {
+        count(p_compound_statement);
+    }
+    void visit(PrintNode &p_print) override { count(p_print); }
+    void visit(BinaryOperatorNode &p_bin_op) override { count(p_bin_op); }
+    void visit(UnaryOperatorNode &p_un_op) override { count(p_un_op); }
+    void visit(FunctionInvocationNode &p_func_invocation) override {
+        count(p_func_invocation);
+    }
+    void visit(VariableReferenceNode &p_variable_ref) override {
+        count(p_variable_ref);
+    }
+    void visit(AssignmentNode &p_assignment) override { count(p_assignment); }
+    void visit(ReadNode &p_read) override { count(p_read); }
+    void visit(IfNode &p_if) override { count(p_if); }
+    void visit(WhileNode &p_while) override { count(p_while); }
+    void visit(ForNode &p_for) override { count(p_for); }
+    void visit(ReturnNode &p_return) override { count(p_return); }
+};
+
+// The same, dispatched statically.
+class StaticNodeCounter final : public AstStaticVisitor<StaticNodeCounter> {
+  private:
+    size_t m_num_of_nodes = 0;
+
+  public:
+    size_t getNumOfNodes() const { return m_num_of_nodes; }
+
+    template <typename Node> void visit(Node &p_node) {
+        ++m_num_of_nodes;
+        visitChildNodes(p_node);
+    }
+};
+
+// The same, walked with a stack of its own.
+class WalkingNodeCounter final : public AstWalker<WalkingNodeCounter> {
+  private:
+    size_t m_num_of_nodes = 0;
+
+  public:
+    size_t getNumOfNodes() const { return m_num_of_nodes; }
+
+    template <typename Node> void preVisit(Node &) { ++m_num_of_nodes; }
+};
+
+// Calls p_count p_num_of_traversals times and returns the calls a second.
+// Each call returns the nodes it counted, which add up to p_num_of_nodes.
+template <typename Count>
+double measureTraversals(const size_t p_num_of_traversals,
+                         const size_t p_num_of_nodes, Count p_count) {
+    size_t num_of_nodes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < p_num_of_traversals; ++i) {
+        num_of_nodes += p_count();
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (num_of_nodes != p_num_of_nodes * p_num_of_traversals) {
+        throw std::logic_error("the traversals counted different nodes");
+    }
+    return elapsed.count() > 0 ? p_num_of_traversals / elapsed.count() : 0.0;
+}
+
+// CompileOptions::num_of_traversals
+void reportTraversals(AstNode &p_root, const size_t p_num_of_traversals,
+                      FILE *const p_diagnostics) {
+    // lazy bodies are parsed on the first walk, which is not measured
+    VirtualNodeCounter first_counter;
+    p_root.accept(first_counter);
+    const size_t num_of_nodes = first_counter.getNumOfNodes();
+
+    const double virtual_rate =
+        measureTraversals(p_num_of_traversals, num_of_nodes, [&p_root]() {
+            VirtualNodeCounter counter;
+            p_root.accept(counter);
+            return counter.getNumOfNodes();
+        });
+    const double static_rate =
+        measureTraversals(p_num_of_traversals, num_of_nodes, [&p_root]() {
+            StaticNodeCounter counter;
+            counter.dispatch(p_root);
+            return counter.getNumOfNodes();
+        });
+    const double walking_rate =
+        measureTraversals(p_num_of_traversals, num_of_nodes, [&p_root]() {
+            WalkingNodeCounter counter;
+            counter.walk(p_root);
+            return counter.getNumOfNodes();
+        });
+    const auto speedup = [virtual_rate](const double p_rate) {
+        return virtual_rate > 0 ? p_rate / virtual_rate : 0.0;
+    };
+    fprintf(p_diagnostics,
+            "traversed %zu nodes %zu times: %.1f/s with AstNodeVisitor, "
+            "%.1f/s with AstStaticVisitor (%.2fx), %.1f/s with AstWalker "
+            "(%.2fx)\n",
+            num_of_nodes, p_num_of_traversals, virtual_rate, static_rate,
+            speedup(static_rate), walking_rate, speedup(walking_rate));
+}
+
+// CompileOptions::ast_stats
+void reportAstStats(AstNode &p_root, const SourceBuffer &p_source,
+                    FILE *const p_diagnostics) {
+    AstStats stats;
+    stats.walk(p_root);
+    LineIndex source_lines(p_source.getData(), p_source.getSize());
+    size_t num_of_lines = source_lines.getNumOfLines();
+    // not the empty line after a final newline
+    if (p_source.getSize() != 0 &&
+        p_source.getData()[p_source.getSize() - 1] == '\n') {
+        --num_of_lines;
+    }
+    stats.report(p_diagnostics, num_of_lines);
+}
+
+bool parse(CompilationContext &p_context, const CompileOptions &p_options) {
+    switch (p_options.parser) {
+    case ParserKind::kDescent:
+        return parseProgramByDescent(p_context);
+    case ParserKind::kBison:
+        break;
+    }
+    return parseProgram(p_context);
+}
+
+// CompileOptions::parse_only
+bool parseAndReport(CompilationContext &p_context,
+                    const CompileOptions &p_options) {
+    const auto start = std::chrono::steady_clock::now();
+    const bool is_parsed = parse(p_context, p_options);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const double mib = p_context.source.getSize() / (1024.0 * 1024.0);
+    fprintf(p_context.diagnostics, "parsed %.1f MiB in %.6f s (%.1f MiB/s)\n",
+            mib, elapsed.count(),
+            elapsed.count() > 0 ? mib / elapsed.count() : 0.0);
+    if (is_parsed && p_options.flat_ast) {
+        // lazy bodies are parsed into the arena first
+        const FlatAst flat_ast(*p_context.root);
+        const size_t num_of_nodes = flat_ast.getNumOfNodes();
+        const size_t arena_bytes = Arena::getInstance().getNumOfBytes();
+        fprintf(p_context.diagnostics,
+                "AST of %zu nodes: %zu bytes in the arena (%.1f per node), "
+                "%zu bytes flat (%.1f per node)\n",
+                num_of_nodes, arena_bytes,
+                static_cast<double>(arena_bytes) / num_of_nodes,
+                flat_ast.getNumOfBytes(),
+                static_cast<double>(flat_ast.getNumOfBytes()) / num_of_nodes);
+    }
+    if (is_parsed && p_options.ast_stats) {
+        reportAstStats(*p_context.root, p_context.source,
+                       p_context.diagnostics);
+    }
+    if (is_parsed && p_options.num_of_traversals != 0) {
+        reportTraversals(*p_context.root, p_options.num_of_traversals,
+                         p_context.diagnostics);
+    }
+    return is_parsed;
+}
+
+// Whether the dump comes after semantic analysis rather than before: the
+// JSON has the types and declarations that the analysis records.
+bool isDumpedAfterAnalysis(const AstDumpFormat p_format) {
+    return p_format == AstDumpFormat::kJson;
+}
+
+// CompileOptions::dump_ast of the AST itself; the dumpers have flushed
+// when this returns
+void dumpAst(AstNode &p_root, const AstDumpFormat p_format,
+             FILE *const p_output) {
+    switch (p_format) {
+    case AstDumpFormat::kText: {
+        AstDumper ast_dumper(p_output);
+        ast_dumper.walk(p_root);
+        break;
+    }
+    case AstDumpFormat::kJson: {
+        AstJsonDumper ast_dumper(p_output);
+        ast_dumper.walk(p_root);
+        break;
+    }
+    case AstDumpFormat::kBinary:
+        writeAstFile(static_cast<ProgramNode &>(p_root), p_output);
+        break;
+    }
+}
+
+// The AST dump, if p_dump_ast, and semantic analysis, printing what they
+// print to one string.
+std::string runPasses(AstNode &p_root, const SourceBuffer &p_source,
+                      const bool p_dump_ast, const AstDumpFormat p_format,
+                      const bool p_dump_symbol_table) {
+    OutputStream output(nullptr);
+    if (p_dump_ast && !isDumpedAfterAnalysis(p_format)) {
+        dumpAst(p_root, p_format, output.get());
+    }
+    LineIndex source_lines(p_source.getData(), p_source.getSize());
+    SemanticAnalyzer sema_analyzer;
+    sema_analyzer.setSymbolTableDump(p_dump_symbol_table);
+    sema_analyzer.setSourceLines(&source_lines);
+    sema_analyzer.setOutput(output.get(), output.get());
+    sema_analyzer.walk(p_root);
+    if (p_dump_ast && isDumpedAfterAnalysis(p_format)) {
+        dumpAst(p_root, p_format, output.get());
+    }
+
+    std::string printed;
+    output.finish(printed);
+    return printed;
+}
+
+// CompileOptions::num_of_concurrent_passes; returns whether all the runs
+// printed the same
+bool checkConcurrentPasses(CompilationContext &p_context,
+                           const CompileOptions &p_options,
+                           const bool p_dump_symbol_table,
+                           const CompileResult &p_result) {
+    AstNode &root = *p_result.ast;
+    if (p_options.lazy_function_bodies) {
+        // which the first walk parses, see AST/ast.hpp
+        WalkingNodeCounter body_parser;
+        body_parser.walk(root);
+    }
+
+    // on the tree as parsed, so that the threads race on anything a pass
+    // writes to it
+    std::vector<std::string> printed(p_options.num_of_concurrent_passes);
+    std::vector<std::thread> threads;
+    for (std::string &thread_printed : printed) {
+        threads.emplace_back([&]() {
+            const StringInterner::Scope atoms_scope(*p_result.atoms);
+            const StringLiteralPool::Scope literals_scope(*p_result.literals);
+            const TypeContext::Scope types_scope(*p_result.types);
+            thread_printed =
+                runPasses(root, p_context.source, p_options.dump_ast,
+                          p_options.ast_dump_format, p_dump_symbol_table);
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    const std::string expected =
+        runPasses(root, p_context.source, p_options.dump_ast,
+                  p_options.ast_dump_format, p_dump_symbol_table);
+
+    size_t num_of_differences = 0;
+    for (const std::string &thread_printed : printed) {
+        if (thread_printed != expected) {
+            ++num_of_differences;
+        }
+    }
+    if (num_of_differences != 0) {
+        fprintf(p_context.diagnostics,
+                "%zu of %zu concurrent runs of the passes printed other than "
+                "a serial run\n",
+                num_of_differences, printed.size());
+        return false;
+    }
+    return true;
+}
+
+// Returns false if CompileOptions::num_of_concurrent_passes found a
+// difference.
+bool analyze(CompilationContext &p_context, const CompileOptions &p_options,
+             const bool p_dump_symbol_table, CompileResult &p_result) {
+    AstNode &root = *p_result.ast;
+    if (p_options.ast_stats) {
+        reportAstStats(root, p_context.source, p_context.diagnostics);
+    }
+    const bool is_consistent =
+        p_options.num_of_concurrent_passes == 0 ||
+        checkConcurrentPasses(p_context, p_options, p_dump_symbol_table,
+                              p_result);
+
+    if (p_options.dump_ast && p_options.flat_ast) {
+        const FlatAst flat_ast(root);
+        FlatAstDumper ast_dumper(flat_ast, p_context.output);
+        flat_ast.walk(flat_ast.getRoot(), ast_dumper);
+    } else if (p_options.dump_ast &&
+               !isDumpedAfterAnalysis(p_options.ast_dump_format)) {
+        dumpAst(root, p_options.ast_dump_format, p_context.output);
+    }
+
+    LineIndex source_lines(p_context.source.getData(),
+                           p_context.source.getSize());
+    SemanticAnalyzer sema_analyzer;
+    sema_analyzer.setSymbolTableDump(p_dump_symbol_table);
+    sema_analyzer.setSourceLines(&source_lines);
+    sema_analyzer.setOutput(p_context.output, p_context.diagnostics);
+    sema_analyzer.walk(root);
+    p_result.num_of_semantic_errors = sema_analyzer.getNumOfErrors();
+    if (p_options.dump_ast && !p_options.flat_ast &&
+        isDumpedAfterAnalysis(p_options.ast_dump_format)) {
+        dumpAst(root, p_options.ast_dump_format, p_context.output);
+    }
+    return is_consistent;
+}
+
+// CompileOptions::stream_functions: the parser hands the program to the
+// analyzer as it goes. The symbol tables wait in a file until the program
+// has parsed and the end of input tells whether to dump them (//&D).
+bool parseAndAnalyze(CompilationContext &p_context,
+                     const CompileOptions &p_options, CompileResult &p_result) {
+    LineIndex source_lines(p_context.source.getData(),
+                           p_context.source.getSize());
+    // errors are listed during the parse, while the flex scanner has put a
+    // NUL after its current token, which may be a newline
+    source_lines.getNumOfLines();
+    TemporaryFile symbol_tables;
+    SemanticAnalyzer sema_analyzer;
+    sema_analyzer.setSourceLines(&source_lines);
+    sema_analyzer.setOutput(symbol_tables.get(), p_context.diagnostics);
+    sema_analyzer.setFunctionsRetained(false);
+
+    p_context.analyzer = &sema_analyzer;
+    const bool is_parsed = parse(p_context, p_options);
+    p_context.analyzer = nullptr;
+    if (!is_parsed) {
+        return false;
+    }
+
+    // the declarations and functions have been analyzed
+    auto &program = static_cast<ProgramNode &>(*p_context.root);
+    sema_analyzer.walk(*program.getBody());
+    sema_analyzer.endProgram();
+    if (p_context.getDumpSymbolTable()) {
+        symbol_tables.copyTo(p_context.output);
+    }
+    sema_analyzer.setOutput(p_context.output, p_context.diagnostics);
+    sema_analyzer.printErrorMessages();
+
+    p_result.ast = p_context.root;
+    p_result.num_of_semantic_errors = sema_analyzer.getNumOfErrors();
+    return true;
+}
+
+// CompileOptions::ast_cache_directory
+bool compileThroughCache(CompilationContext &p_context,
+                         const CompileOptions &p_options,
+                         CompileResult &p_result) {
+    const AstCache cache(p_options.ast_cache_directory);
+    bool dump_symbol_table = false;
+    p_result.ast =
+        cache.load(p_context.source, p_context.output, dump_symbol_table);
+    if (p_result.ast != nullptr) {
+        return analyze(p_context, p_options, dump_symbol_table, p_result);
+    }
+
+    // the listing goes into the entry as well
+    FILE *const output = p_context.output;
+    OutputStream listing_stream(nullptr);
+    p_context.output = listing_stream.get();
+    startLexer(p_context, p_options);
+    const bool is_parsed = parse(p_context, p_options);
+    p_context.output = output;
+    std::string listing;
+    listing_stream.finish(listing);
+    if (output != nullptr) {
+        fwrite(listing.data(), 1, listing.size(), output);
+    }
+    if (!is_parsed) {
+        return false;
+    }
+
+    dump_symbol_table = p_context.getDumpSymbolTable();
+    p_result.ast = p_context.root;
+    cache.store(p_context.source, static_cast<ProgramNode &>(*p_result.ast),
+                listing, dump_symbol_table);
+    return analyze(p_context, p_options, dump_symbol_table, p_result);
+}
+
+} // namespace
+
+const char *getOptionsError(const CompileOptions &p_options) {
+    const bool has_lexer_threads = p_options.lexer == LexerKind::kThreaded ||
+                                   p_options.lexer == LexerKind::kParallel;
+    if (p_options.stream_functions && has_lexer_threads) {
+        return "functions cannot be streamed with the threaded or the "
+               "parallel lexer";
+    }
+    return nullptr;
+}
+
+CompileResult compile(SourceBuffer &p_source, const CompileOptions &p_options) {
+    if (const char *const error = getOptionsError(p_options)) {
+        throw std::invalid_argument(error);
+    }
+    CompileResult result;
+    result.arena.reset(new Arena());
+    result.atoms.reset(new StringInterner());
+    result.literals.reset(new StringLiteralPool());
+    result.types.reset(new TypeContext());
+    const Arena::Scope arena_scope(*result.arena);
+    const StringInterner::Scope atoms_scope(*result.atoms);
+    const StringLiteralPool::Scope literals_scope(*result.literals);
+    const TypeContext::Scope types_scope(*result.types);
+
+    OutputStream output(p_options.output);
+    OutputStream diagnostics(p_options.diagnostics);
+    {
+        CompilationContext context(p_source, output.get(), diagnostics.get());
+        const bool use_cache =
+            p_options.ast_cache_directory != nullptr && !p_options.lex_only &&
+            !p_options.syntax_only && !p_options.parse_only &&
+            !p_options.lazy_function_bodies && !p_options.stream_functions;
+        if (!use_cache) {
+            startLexer(context, p_options);
+        }
+        if (p_options.lazy_function_bodies) {
+            context.lazy_bodies = newInArena<LazyFunctionBody::Source>();
+            context.lazy_bodies->buffer = &p_source;
+            context.lazy_bodies->diagnostics = diagnostics.get();
+            context.lazy_bodies->by_descent =
+                p_options.parser == ParserKind::kDescent;
+        }
+
+        if (use_cache) {
+            result.is_successful =
+                compileThroughCache(context, p_options, result);
+        } else if (p_options.lex_only) {
+            result.is_successful = lexProgram(context);
+        } else if (p_options.syntax_only) {
+            result.is_successful = checkSyntax(context);
+        } else if (p_options.parse_only) {
+            result.is_successful = parseAndReport(context, p_options);
+            if (result.is_successful) {
+                result.ast = context.root;
+            }
+        } else if (p_options.stream_functions) {
+            result.is_successful = parseAndAnalyze(context, p_options, result);
+        } else if (parse(context, p_options)) {
+            result.ast = context.root;
+            result.is_successful = analyze(
+                context, p_options, context.getDumpSymbolTable(), result);
+        }
+        if (context.lazy_bodies != nullptr) {
+            if (context.lazy_bodies->has_error) {
+                result.is_successful = false;
+            }
+            // the stream may be gone when the next body is parsed
+            context.lazy_bodies->diagnostics = nullptr;
+        }
+    }
+    output.finish(result.output);
+    diagnostics.finish(result.diagnostics);
+    return result;
+}
+
+CompileResult compile(const char *const p_source, const size_t p_size,
+                      const CompileOptions &p_options) {
+    std::unique_ptr<SourceBuffer> source(new SourceBuffer());
+    if (!source->assign(p_source, p_size)) {
+        throw std::bad_alloc();
+    }
+    CompileResult result = compile(*source, p_options);
+    result.source = std::move(source);
+    return result;
+}
@@ -0,0 +1,626 @@
+#include "lexer/FastLexer.hpp"
+
+#include "lexer/Keyword.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr ptrdiff_t kVectorWidth = 16;
+
+// Character classes of the scanner.l rules. Each provides a scalar test and,
+// with SSE2, a test of 16 bytes at once that sets the bytes in the class to
+// 0xFF. Bytes >= 0x80 compare negative and so never fall in an ASCII range.
+#ifdef __SSE2__
+inline __m128i isInRange(const __m128i p_bytes, const char p_low,
+                         const char p_high) {
+    return _mm_and_si128(_mm_cmpgt_epi8(p_bytes, _mm_set1_epi8(p_low - 1)),
+                         _mm_cmplt_epi8(p_bytes, _mm_set1_epi8(p_high + 1)));
+}
+
+inline __m128i isEqual(const __m128i p_bytes, const char p_char) {
+    return _mm_cmpeq_epi8(p_bytes, _mm_set1_epi8(p_char));
+}
+#endif
+
+inline bool isDigitChar(const char p_char) {
+    return p_char >= '0' && p_char <= '9';
+}
+
+inline bool isAlphaChar(const char p_char) {
+    const char lower = static_cast<char>(p_char | 0x20);
+    return lower >= 'a' && lower <= 'z';
+}
+
+// [ \t]
+struct Blank {
+    static bool test(const char p_char) {
+        return p_char == ' ' || p_char == '\t';
+    }
+#ifdef __SSE2__
+    static __m128i test(const __m128i p_bytes) {
+        return _mm_or_si128(isEqual(p_bytes, ' '), isEqual(p_bytes, '\t'));
+    }
+#endif
+};
+
+// [0-9]
+struct Digit {
+    static bool test(const char p_char) { return isDigitChar(p_char); }
+#ifdef __SSE2__
+    static __m128i test(const __m128i p_bytes) {
+        return isInRange(p_bytes, '0', '9');
+    }
+#endif
+};
+
+// [a-zA-Z0-9]
+struct AlphaNumeric {
+    static bool test(const char p_char) {
+        return isAlphaChar(p_char) || isDigitChar(p_char);
+    }
+#ifdef __SSE2__
+    static __m128i test(const __m128i p_bytes) {
+        const __m128i lower = _mm_or_si128(p_bytes, _mm_set1_epi8(0x20));
+        return _mm_or_si128(isInRange(lower, 'a', 'z'),
+                            isInRange(p_bytes, '0', '9'));
+    }
+#endif
+};
+
+// [^"\n], the body of a string literal
+struct StringChar {
+    static bool test(const char p_char) {
+        return p_char != '"' && p_char != '\n';
+    }
+#ifdef __SSE2__
+    static __m128i test(const __m128i p_bytes) {
+        return _mm_andnot_si128(
+            _mm_or_si128(isEqual(p_bytes, '"'), isEqual(p_bytes, '\n')),
+            _mm_set1_epi8(-1));
+    }
+#endif
+};
+
+// [^*\n], what the CCOMMENT "." rule can skip without a closer look
+struct CommentChar {
+    static bool test(const char p_char) {
+        return p_char != '*' && p_char != '\n';
+    }
+#ifdef __SSE2__
+    static __m128i test(const __m128i p_bytes) {
+        return _mm_andnot_si128(
+            _mm_or_si128(isEqual(p_bytes, '*'), isEqual(p_bytes, '\n')),
+            _mm_set1_epi8(-1));
+    }
+#endif
+};
+
+// [^"/\n], what cannot change whether a C-style comment is open
+struct PlainChar {
+    static bool test(const char p_char) {
+        return p_char != '"' && p_char != '/' && p_char != '\n';
+    }
+#ifdef __SSE2__
+    static __m128i test(const __m128i p_bytes) {
+        return _mm_andnot_si128(
+            _mm_or_si128(_mm_or_si128(isEqual(p_bytes, '"'),
+                                      isEqual(p_bytes, '/')),
+                         isEqual(p_bytes, '\n')),
+            _mm_set1_epi8(-1));
+    }
+#endif
+};
+
+// returns the first position in [p_begin, p_end) whose byte is not in Class
+template <typename Class>
+const char *skipWhile(const char *p_begin, const char *const p_end) {
+#ifdef __SSE2__
+    while (p_end - p_begin >= kVectorWidth) {
+        const __m128i bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_begin));
+        const unsigned int rejected =
+            ~static_cast<unsigned int>(_mm_movemask_epi8(Class::test(bytes))) &
+            0xFFFFu;
+        if (rejected != 0) {
+            return p_begin + __builtin_ctz(rejected);
+        }
+        p_begin += kVectorWidth;
+    }
+#endif
+    while (p_begin != p_end && Class::test(*p_begin)) {
+        ++p_begin;
+    }
+    return p_begin;
+}
+
+const char *findLineEnd(const char *const p_begin, const char *const p_end) {
+    const char *const newline = static_cast<const char *>(
+        std::memchr(p_begin, '\n', static_cast<size_t>(p_end - p_begin)));
+    return newline ? newline : p_end;
+}
+
+// "//&"[STD][+-].*, [p_comment, p_comment_end) being a C++ style comment
+void applyPseudocomment(const char *const p_comment,
+                        const char *const p_comment_end,
+                        FastLexer::PseudocommentStates &p_states) {
+    if (p_comment_end - p_comment < 5 || p_comment[2] != '&' ||
+        (p_comment[4] != '+' && p_comment[4] != '-')) {
+        return;
+    }
+
+    const bool option = p_comment[4] == '+';
+    switch (p_comment[3]) {
+    case 'S':
+        p_states.list_source = option;
+        break;
+    case 'T':
+        p_states.list_token = option;
+        break;
+    case 'D':
+        p_states.dump_symbol_table = option;
+        break;
+    default:
+        break;
+    }
+}
+
+// \"([^"\n]|\"\")*\" at p_quote; the longest match ends at the last closing
+// quote reachable without crossing a newline. Returns nullptr if there is
+// none, in which case the quote is a bad character.
+const char *findStringEnd(const char *const p_quote, const char *const p_end,
+                          bool &p_has_escaped_quote) {
+    const char *match_end = nullptr;
+    p_has_escaped_quote = false;
+    for (const char *p = p_quote + 1;;) {
+        p = skipWhile<StringChar>(p, p_end);
+        if (p == p_end || *p == '\n') {
+            return match_end;
+        }
+        match_end = p + 1;
+        if (p + 1 == p_end || p[1] != '"') {
+            return match_end;
+        }
+        p_has_escaped_quote = true;
+        p += 2;
+    }
+}
+
+// what LIST_TOKEN prints for each kind in scanner.l
+const char *const kTokenListingNames[kNumOfTokenKinds] = {
+    "",        ",",         ";",        ":",        "(",        ")",
+    "[",       "]",         "+",        "-",        "*",        "/",
+    "mod",     ":=",        "<",        "<=",       "<>",       ">=",
+    ">",       "=",         "and",      "or",       "not",      "KWvar",
+    "KWarray", "KWof",      "KWboolean", "KWinteger", "KWreal", "KWstring",
+    "KWtrue",  "KWfalse",   "KWdef",    "KWreturn", "KWbegin",  "KWend",
+    "KWwhile", "KWdo",      "KWif",     "KWthen",   "KWelse",   "KWfor",
+    "KWto",    "KWprint",   "KWread",   "",         "",         "",
+    "",        ""};
+
+} // namespace
+
+void FastLexer::listToken(const TokenKind p_kind) {
+    if (m_states.list_token) {
+        m_listing += '<';
+        m_listing += kTokenListingNames[static_cast<size_t>(p_kind)];
+        m_listing += ">\n";
+    }
+}
+
+void FastLexer::listLiteral(const char *const p_name, const char *const p_text,
+                            const size_t p_length) {
+    if (m_states.list_token) {
+        m_listing += '<';
+        m_listing += p_name;
+        m_listing += ": ";
+        m_listing.append(p_text, p_length);
+        m_listing += ">\n";
+    }
+}
+
+const char *FastLexer::copyToScratch(const char *const p_text,
+                                     const size_t p_length) {
+    m_scratch.assign(p_text, p_length);
+    return m_scratch.c_str();
+}
+
+void FastLexer::scanNewline() {
+    if (m_states.list_source) {
+        m_listing += std::to_string(m_line);
+        m_listing += ": ";
+        m_listing.append(m_line_start,
+                         static_cast<size_t>(m_cursor - m_line_start));
+        m_listing += '\n';
+    }
+
+    ++m_line;
+    ++m_cursor;
+    m_line_start = m_cursor;
+}
+
+void FastLexer::scanLineComment() {
+    const char *const comment_end = findLineEnd(m_cursor, m_end);
+    applyPseudocomment(m_cursor, comment_end, m_states);
+    m_cursor = comment_end;
+}
+
+void FastLexer::scanBlockComment() {
+    if (*m_cursor != '*') {
+        m_cursor = skipWhile<CommentChar>(m_cursor, m_end);
+    } else if (m_cursor + 1 != m_end && m_cursor[1] == '/') {
+        m_cursor += 2;
+        m_in_comment = false;
+    } else {
+        ++m_cursor;
+    }
+}
+
+void FastLexer::scanIdentifierOrKeyword(Token &p_token) {
+    const char *const word_end = skipWhile<AlphaNumeric>(m_cursor + 1, m_end);
+    const size_t length = static_cast<size_t>(word_end - m_cursor);
+
+    const Keyword *const keyword = lookUpKeyword(m_cursor, length);
+    p_token.kind = keyword ? keyword->kind : TokenKind::kIdentifier;
+    p_token.length = static_cast<uint32_t>(length);
+    switch (p_token.kind) {
+    case TokenKind::kIdentifier:
+        listLiteral("id", m_cursor, length);
+        p_token.value.identifier = m_atoms->intern(std::string_view(
+            m_cursor, length < kMaxIdentifierLength ? length
+                                                    : kMaxIdentifierLength));
+        break;
+    case TokenKind::kTrue:
+    case TokenKind::kFalse:
+        listToken(p_token.kind);
+        p_token.value.boolean = p_token.kind == TokenKind::kTrue;
+        break;
+    default:
+        listToken(p_token.kind);
+        break;
+    }
+}
+
+void FastLexer::scanNumber(Token &p_token) {
+    const char *const begin = m_cursor;
+    const auto char_at = [this](const char *const p) {
+        return p < m_end ? *p : '\0';
+    };
+    const auto last_nonzero_end = [](const char *p_begin, const char *p_end) {
+        while (p_end != p_begin && p_end[-1] == '0') {
+            --p_end;
+        }
+        return p_end;
+    };
+
+    // {integer}: 0|[1-9][0-9]*
+    const char *const integer_end =
+        (*begin == '0') ? begin + 1 : skipWhile<Digit>(begin, m_end);
+
+    // 0[0-7]+
+    const char *oct_integer_end = begin;
+    if (*begin == '0') {
+        const char *p = begin + 1;
+        while (char_at(p) >= '0' && char_at(p) <= '7') {
+            ++p;
+        }
+        if (p - begin >= 2) {
+            oct_integer_end = p;
+        }
+    }
+
+    // {float}: {integer}\.(0|[0-9]*[1-9])
+    const char *float_end = begin;
+    if (char_at(integer_end) == '.') {
+        const char *const fraction = integer_end + 1;
+        const char *const digits_end = skipWhile<Digit>(fraction, m_end);
+        const char *const fraction_end = last_nonzero_end(fraction, digits_end);
+        if (fraction_end != fraction) {
+            float_end = fraction_end;
+        } else if (char_at(fraction) == '0') {
+            float_end = fraction + 1;
+        }
+    }
+
+    // ({nonzero_integer}|{nonzero_float})[Ee][+-]?({integer})
+    // The mantissa is directly followed by [Ee], so each of its digit runs
+    // is taken whole.
+    const char *scientific_end = begin;
+    const char *mantissa_end = nullptr;
+    const char *const digits_end = skipWhile<Digit>(begin, m_end);
+    if (char_at(digits_end) == '.' && (*begin != '0' || digits_end == begin + 1)) {
+        const char *const fraction = digits_end + 1;
+        const char *const fraction_end = skipWhile<Digit>(fraction, m_end);
+        const bool is_zero_fraction =
+            fraction_end == fraction + 1 && *fraction == '0';
+        if (fraction_end != fraction && fraction_end[-1] != '0') {
+            mantissa_end = fraction_end;
+        } else if (is_zero_fraction && *begin != '0') {
+            mantissa_end = fraction_end;
+        }
+    } else if (*begin != '0') {
+        mantissa_end = digits_end;
+    }
+    if (mantissa_end != nullptr &&
+        (char_at(mantissa_end) == 'e' || char_at(mantissa_end) == 'E')) {
+        const char *exponent = mantissa_end + 1;
+        if (char_at(exponent) == '+' || char_at(exponent) == '-') {
+            ++exponent;
+        }
+        if (char_at(exponent) == '0') {
+            scientific_end = exponent + 1;
+        } else if (char_at(exponent) >= '1' && char_at(exponent) <= '9') {
+            scientific_end = skipWhile<Digit>(exponent, m_end);
+        }
+    }
+
+    // longest match; on a tie the earlier rule wins
+    enum { kInteger, kOctInteger, kFloat, kScientific } rule = kInteger;
+    const char *token_end = integer_end;
+    if (oct_integer_end > token_end) {
+        token_end = oct_integer_end;
+        rule = kOctInteger;
+    }
+    if (float_end > token_end) {
+        token_end = float_end;
+        rule = kFloat;
+    }
+    if (scientific_end > token_end) {
+        token_end = scientific_end;
+        rule = kScientific;
+    }
+
+    static const char *const kRuleNames[] = {"integer", "oct_integer", "float",
+                                             "scientific"};
+    const size_t length = static_cast<size_t>(token_end - begin);
+    const char *const text = copyToScratch(begin, length);
+    listLiteral(kRuleNames[rule], text, length);
+
+    p_token.length = static_cast<uint32_t>(length);
+    switch (rule) {
+    case kInteger:
+        p_token.kind = TokenKind::kIntLiteral;
+        p_token.value.integer = strtol(text, NULL, 10);
+        break;
+    case kOctInteger:
+        p_token.kind = TokenKind::kIntLiteral;
+        p_token.value.integer = strtol(text, NULL, 8);
+        break;
+    case kFloat:
+    case kScientific:
+        p_token.kind = TokenKind::kRealLiteral;
+        p_token.value.real = atof(text);
+        break;
+    }
+}
+
+bool FastLexer::scanString(Token &p_token) {
+    bool has_escaped_quote;
+    const char *const match_end =
+        findStringEnd(m_cursor, m_end, has_escaped_quote);
+    if (match_end == nullptr) {
+        return false;
+    }
+
+    // skip the enclosing double quotes; two double quotes "" in a string
+    // literal stand for one
+    std::string_view literal(m_cursor + 1,
+                             static_cast<size_t>(match_end - m_cursor) - 2);
+    if (has_escaped_quote) {
+        m_scratch.clear();
+        for (size_t i = 0; i < literal.size(); ++i) {
+            m_scratch += literal[i];
+            if (literal[i] == '"') {
+                ++i; // skip the second double quote
+            }
+        }
+        literal = m_scratch;
+    }
+
+    p_token.kind = TokenKind::kStringLiteral;
+    p_token.length = static_cast<uint32_t>(match_end - m_cursor);
+    p_token.value.string = m_literals->add(literal);
+    if (m_states.list_token) {
+        const char *const text = m_literals->getCString(p_token.value.string);
+        listLiteral("string", text, std::strlen(text));
+    }
+    return true;
+}
+
+void FastLexer::next(Token &p_token) {
+    for (;;) {
+        p_token.line = m_line;
+        p_token.col = static_cast<uint32_t>(m_cursor - m_line_start) + 1;
+        p_token.offset = static_cast<uint32_t>(m_cursor - m_source);
+        p_token.length = 1;
+
+        if (m_cursor == m_end) {
+            p_token.kind = TokenKind::kEndOfInput;
+            p_token.length = 0;
+            return;
+        }
+
+        const char current = *m_cursor;
+        if (current == '\n') {
+            scanNewline();
+            continue;
+        }
+        if (m_in_comment) {
+            scanBlockComment();
+            continue;
+        }
+
+        const char following = (m_cursor + 1 != m_end) ? m_cursor[1] : '\0';
+        switch (current) {
+        case ' ':
+        case '\t':
+            m_cursor = skipWhile<Blank>(m_cursor + 1, m_end);
+            continue;
+        case ',':
+            p_token.kind = TokenKind::kComma;
+            break;
+        case ';':
+            p_token.kind = TokenKind::kSemicolon;
+            break;
+        case ':':
+            if (following == '=') {
+                p_token.kind = TokenKind::kAssign;
+                p_token.length = 2;
+            } else {
+                p_token.kind = TokenKind::kColon;
+            }
+            break;
+        case '(':
+            p_token.kind = TokenKind::kLeftParenthesis;
+            break;
+        case ')':
+            p_token.kind = TokenKind::kRightParenthesis;
+            break;
+        case '[':
+            p_token.kind = TokenKind::kLeftBracket;
+            break;
+        case ']':
+            p_token.kind = TokenKind::kRightBracket;
+            break;
+        case '+':
+            p_token.kind = TokenKind::kPlus;
+            break;
+        case '-':
+            p_token.kind = TokenKind::kMinus;
+            break;
+        case '*':
+            p_token.kind = TokenKind::kMultiply;
+            break;
+        case '/':
+            if (following == '/') {
+                scanLineComment();
+                continue;
+            }
+            if (following == '*') {
+                m_cursor += 2;
+                m_in_comment = true;
+                continue;
+            }
+            p_token.kind = TokenKind::kDivide;
+            break;
+        case '<':
+            if (following == '=') {
+                p_token.kind = TokenKind::kLessOrEqual;
+                p_token.length = 2;
+            } else if (following == '>') {
+                p_token.kind = TokenKind::kNotEqual;
+                p_token.length = 2;
+            } else {
+                p_token.kind = TokenKind::kLess;
+            }
+            break;
+        case '>':
+            if (following == '=') {
+                p_token.kind = TokenKind::kGreaterOrEqual;
+                p_token.length = 2;
+            } else {
+                p_token.kind = TokenKind::kGreater;
+            }
+            break;
+        case '=':
+            p_token.kind = TokenKind::kEqual;
+            break;
+        case '"':
+            if (!scanString(p_token)) {
+                p_token.kind = TokenKind::kBadCharacter;
+            }
+            m_cursor += p_token.length;
+            return;
+        default:
+            if (isAlphaChar(current)) {
+                scanIdentifierOrKeyword(p_token);
+            } else if (isDigitChar(current)) {
+                scanNumber(p_token);
+            } else {
+                p_token.kind = TokenKind::kBadCharacter;
+            }
+            m_cursor += p_token.length;
+            return;
+        }
+
+        // delimiters and symbolic operators
+        listToken(p_token.kind);
+        m_cursor += p_token.length;
+        return;
+    }
+}
+
+std::vector<FastLexer::ChunkStart>
+FastLexer::findChunkStarts(const char *const p_source, const size_t p_size,
+                           const size_t p_num_of_chunks) {
+    // Only whether a C-style comment is open has to be tracked: string
+    // literals and C++ style comments end at the newline. Both still have to
+    // be skipped, though, since "/*" does not open a comment inside them.
+    ChunkStart start{0, 1, PseudocommentStates()};
+    std::vector<ChunkStart> starts{start};
+
+    const char *const end = p_source + p_size;
+    bool in_comment = false;
+    size_t split_target = p_size / p_num_of_chunks;
+    for (const char *p = p_source; starts.size() < p_num_of_chunks;) {
+        if (in_comment) {
+            p = skipWhile<CommentChar>(p, end);
+            if (p == end) {
+                break;
+            }
+            if (*p == '*') {
+                if (p + 1 != end && p[1] == '/') {
+                    in_comment = false;
+                    ++p;
+                }
+                ++p;
+                continue;
+            }
+        } else {
+            p = skipWhile<PlainChar>(p, end);
+            if (p == end) {
+                break;
+            }
+            if (*p == '"') {
+                bool has_escaped_quote;
+                const char *const string_end =
+                    findStringEnd(p, end, has_escaped_quote);
+                p = string_end ? string_end : p + 1;
+                continue;
+            }
+            if (*p == '/') {
+                const char following = (p + 1 != end) ? p[1] : '\0';
+                if (following == '/') {
+                    const char *const comment_end = findLineEnd(p, end);
+                    applyPseudocomment(p, comment_end, start.states);
+                    p = comment_end;
+                } else if (following == '*') {
+                    in_comment = true;
+                    p += 2;
+                } else {
+                    ++p;
+                }
+                continue;
+            }
+        }
+
+        // a newline
+        ++p;
+        ++start.line;
+        const size_t offset = static_cast<size_t>(p - p_source);
+        if (!in_comment && offset >= split_target && offset != p_size) {
+            start.offset = static_cast<uint32_t>(offset);
+            starts.push_back(start);
+            // share what is left among the remaining parts
+            split_target =
+                offset + (p_size - offset) / (p_num_of_chunks - starts.size() + 1);
+        }
+    }
+    return starts;
+}
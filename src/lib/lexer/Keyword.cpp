@@ -0,0 +1,119 @@
+#include "lexer/Keyword.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+constexpr Keyword kKeywords[] = {
+    {"mod", TokenKind::kMod, "mod"},
+    {"and", TokenKind::kAnd, "and"},
+    {"or", TokenKind::kOr, "or"},
+    {"not", TokenKind::kNot, "not"},
+    {"var", TokenKind::kVar, "KWvar"},
+    {"array", TokenKind::kArray, "KWarray"},
+    {"of", TokenKind::kOf, "KWof"},
+    {"boolean", TokenKind::kBoolean, "KWboolean"},
+    {"integer", TokenKind::kInteger, "KWinteger"},
+    {"real", TokenKind::kReal, "KWreal"},
+    {"string", TokenKind::kString, "KWstring"},
+    {"true", TokenKind::kTrue, "KWtrue"},
+    {"false", TokenKind::kFalse, "KWfalse"},
+    {"def", TokenKind::kDef, "KWdef"},
+    {"return", TokenKind::kReturn, "KWreturn"},
+    {"begin", TokenKind::kBegin, "KWbegin"},
+    {"end", TokenKind::kEnd, "KWend"},
+    {"while", TokenKind::kWhile, "KWwhile"},
+    {"do", TokenKind::kDo, "KWdo"},
+    {"if", TokenKind::kIf, "KWif"},
+    {"then", TokenKind::kThen, "KWthen"},
+    {"else", TokenKind::kElse, "KWelse"},
+    {"for", TokenKind::kFor, "KWfor"},
+    {"to", TokenKind::kTo, "KWto"},
+    {"print", TokenKind::kPrint, "KWprint"},
+    {"read", TokenKind::kRead, "KWread"},
+};
+
+constexpr size_t kNumOfKeywords = sizeof(kKeywords) / sizeof(kKeywords[0]);
+constexpr size_t kMinKeywordLength = 2;
+constexpr size_t kMaxKeywordLength = 7;
+
+constexpr uint32_t kNumOfSlotBits = 7;
+constexpr uint32_t kNumOfSlots = 1u << kNumOfSlotBits;
+constexpr uint8_t kEmptySlot = UINT8_MAX;
+
+// The first, second and last characters and the length of a word are packed
+// into 32 bits and multiplied by a seed; the top bits pick the slot.
+// p_length must be at least kMinKeywordLength.
+constexpr uint32_t hashWord(const char *const p_word, const size_t p_length,
+                            const uint32_t p_seed) {
+    const uint32_t key =
+        static_cast<uint32_t>(static_cast<uint8_t>(p_word[0])) |
+        static_cast<uint32_t>(static_cast<uint8_t>(p_word[1])) << 8 |
+        static_cast<uint32_t>(static_cast<uint8_t>(p_word[p_length - 1]))
+            << 16 |
+        static_cast<uint32_t>(p_length) << 24;
+    return (key * p_seed) >> (32 - kNumOfSlotBits);
+}
+
+constexpr bool isPerfect(const uint32_t p_seed) {
+    bool is_used[kNumOfSlots] = {};
+    for (const auto &keyword : kKeywords) {
+        const uint32_t slot =
+            hashWord(keyword.spelling.data(), keyword.spelling.size(), p_seed);
+        if (is_used[slot]) {
+            return false;
+        }
+        is_used[slot] = true;
+    }
+    return true;
+}
+
+// the first odd multiplier of a fixed LCG sequence that has no collisions
+constexpr uint32_t findSeed() {
+    uint32_t seed = 0x9E3779B1u;
+    while (!isPerfect(seed)) {
+        seed = (seed * 1664525u + 1013904223u) | 1u;
+    }
+    return seed;
+}
+
+constexpr uint32_t kSeed = findSeed();
+
+struct Slots {
+    uint8_t keyword_indices[kNumOfSlots];
+};
+
+constexpr Slots buildSlots() {
+    Slots slots{};
+    for (auto &index : slots.keyword_indices) {
+        index = kEmptySlot;
+    }
+    for (size_t i = 0; i < kNumOfKeywords; ++i) {
+        const std::string_view spelling = kKeywords[i].spelling;
+        slots.keyword_indices[hashWord(spelling.data(), spelling.size(),
+                                       kSeed)] = static_cast<uint8_t>(i);
+    }
+    return slots;
+}
+
+constexpr Slots kSlots = buildSlots();
+
+} // namespace
+
+const Keyword *lookUpKeyword(const char *const p_word, const size_t p_length) {
+    if (p_length < kMinKeywordLength || p_length > kMaxKeywordLength) {
+        return nullptr;
+    }
+    const uint8_t index =
+        kSlots.keyword_indices[hashWord(p_word, p_length, kSeed)];
+    if (index == kEmptySlot) {
+        return nullptr;
+    }
+    const Keyword &keyword = kKeywords[index];
+    if (keyword.spelling.size() != p_length ||
+        std::memcmp(keyword.spelling.data(), p_word, p_length) != 0) {
+        return nullptr;
+    }
+    return &keyword;
+}
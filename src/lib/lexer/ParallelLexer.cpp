@@ -0,0 +1,162 @@
+#include "lexer/ParallelLexer.hpp"
+
+#include <algorithm>
+
+// how often a chunk checks whether the consumer has given up
+static constexpr size_t kStopCheckInterval = 4096;
+
+ParallelLexer::ParallelLexer(const char *const p_source, const size_t p_size,
+                             const size_t p_num_of_threads)
+    : m_source(p_source), m_atoms(&StringInterner::getInstance()),
+      m_literals(&StringLiteralPool::getInstance()) {
+    const size_t num_of_chunks = std::max<size_t>(
+        1, std::min(p_num_of_threads, p_size / kMinChunkSize));
+    const std::vector<FastLexer::ChunkStart> starts =
+        FastLexer::findChunkStarts(p_source, p_size, num_of_chunks);
+
+    for (size_t i = 0; i < starts.size(); ++i) {
+        m_chunks.emplace_back(new Chunk());
+        m_chunks.back()->start = starts[i];
+        m_chunks.back()->end =
+            (i + 1 < starts.size()) ? starts[i + 1].offset : p_size;
+    }
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+        m_threads.emplace_back(&ParallelLexer::scanChunk, this, i);
+    }
+}
+
+ParallelLexer::~ParallelLexer() {
+    // the consumer may give up before the end of input (e.g. exit() on a
+    // syntax error)
+    m_is_stopping.store(true, std::memory_order_relaxed);
+    m_condition.notify_all();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ParallelLexer::scanChunk(const size_t p_index) {
+    Chunk &chunk = *m_chunks[p_index];
+    FastLexer lexer(m_source, chunk.end, chunk.start, chunk.atoms,
+                    chunk.literals);
+
+    std::string &listing = lexer.getListing();
+    for (;;) {
+        chunk.tokens.emplace_back();
+        Token &token = chunk.tokens.back();
+        lexer.next(token);
+        chunk.listing_ends.push_back(static_cast<uint32_t>(listing.size()));
+
+        if (token.kind == TokenKind::kEndOfInput ||
+            token.kind == TokenKind::kBadCharacter) {
+            break;
+        }
+        if (chunk.tokens.size() % kStopCheckInterval == 0 &&
+            m_is_stopping.load(std::memory_order_relaxed)) {
+            return;
+        }
+    }
+    chunk.listing.swap(listing);
+    chunk.dump_symbol_table = lexer.getDumpSymbolTable();
+
+    // merge in chunk order
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this, p_index] {
+            return m_num_of_merged_chunks == p_index ||
+                   m_is_stopping.load(std::memory_order_relaxed);
+        });
+        if (m_num_of_merged_chunks != p_index) {
+            return;
+        }
+    }
+    mergeChunk(chunk);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_num_of_merged_chunks;
+        chunk.is_ready = true;
+    }
+    m_condition.notify_all();
+}
+
+// Called by one chunk at a time, in chunk order, so the merged tables are
+// never used concurrently.
+void ParallelLexer::mergeChunk(Chunk &p_chunk) {
+    std::vector<Atom> atoms(p_chunk.atoms.getNumOfAtoms());
+    for (Atom atom = 0; atom < atoms.size(); ++atom) {
+        atoms[atom] = m_atoms->intern(p_chunk.atoms.getString(atom));
+    }
+
+    std::vector<StringLiteralId> literals(p_chunk.literals.getNumOfLiterals());
+    for (StringLiteralId id = 0; id < literals.size(); ++id) {
+        literals[id] = m_literals->add(p_chunk.literals.getString(id));
+    }
+
+    for (Token &token : p_chunk.tokens) {
+        if (token.kind == TokenKind::kIdentifier) {
+            token.value.identifier = atoms[token.value.identifier];
+        } else if (token.kind == TokenKind::kStringLiteral) {
+            token.value.string = literals[token.value.string];
+        }
+    }
+}
+
+ParallelLexer::Chunk &ParallelLexer::waitForChunk(const size_t p_index) {
+    Chunk &chunk = *m_chunks[p_index];
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [&chunk] { return chunk.is_ready; });
+    return chunk;
+}
+
+void ParallelLexer::next(Token &p_token) {
+    // the end of input repeats, as with FastLexer
+    if (m_is_at_end) {
+        p_token = m_chunks.back()->tokens.back();
+        m_listing = std::string_view();
+        return;
+    }
+
+    bool is_joined = false;
+    for (;;) {
+        Chunk &chunk = (m_token_index == 0) ? waitForChunk(m_chunk_index)
+                                            : *m_chunks[m_chunk_index];
+        const size_t index = m_token_index++;
+        const uint32_t listing_begin =
+            (index == 0) ? 0 : chunk.listing_ends[index - 1];
+        const std::string_view listing =
+            std::string_view(chunk.listing)
+                .substr(listing_begin,
+                        chunk.listing_ends[index] - listing_begin);
+        const Token &token = chunk.tokens[index];
+
+        if (token.kind == TokenKind::kEndOfInput &&
+            m_chunk_index + 1 < m_chunks.size()) {
+            // the end of a chunk, not of the source; what it listed after
+            // its last token goes before the first token of the next one
+            if (!is_joined) {
+                m_joined_listing.clear();
+                is_joined = true;
+            }
+            m_joined_listing.append(listing);
+
+            // the chunk has been read through
+            std::vector<Token>().swap(chunk.tokens);
+            std::vector<uint32_t>().swap(chunk.listing_ends);
+            std::string().swap(chunk.listing);
+            ++m_chunk_index;
+            m_token_index = 0;
+            continue;
+        }
+
+        if (is_joined) {
+            m_joined_listing.append(listing);
+            m_listing = m_joined_listing;
+        } else {
+            m_listing = listing;
+        }
+        p_token = token;
+        m_is_at_end = token.kind == TokenKind::kEndOfInput;
+        return;
+    }
+}
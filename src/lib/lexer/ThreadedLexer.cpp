@@ -0,0 +1,97 @@
+#include "lexer/ThreadedLexer.hpp"
+
+// spins this many times on an empty or full ring before yielding the core
+static constexpr int kNumOfSpins = 64;
+
+ThreadedLexer::ThreadedLexer(const char *const p_source, const size_t p_size)
+    : m_lexer(p_source, p_size), m_batches(kNumOfBatches) {
+    m_thread = std::thread(&ThreadedLexer::run, this);
+}
+
+ThreadedLexer::~ThreadedLexer() {
+    // the parser may stop before the end of input (e.g. when it fails on a
+    // syntax error), so the lexer thread could be waiting for a free batch
+    m_is_stopping.store(true, std::memory_order_relaxed);
+    join();
+}
+
+void ThreadedLexer::join() {
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void ThreadedLexer::run() {
+    while (!m_is_stopping.load(std::memory_order_relaxed)) {
+        Batch *batch;
+        for (int spins = 0; (batch = m_batches.getPushSlot()) == nullptr;
+             ++spins) {
+            if (m_is_stopping.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if (spins >= kNumOfSpins) {
+                std::this_thread::yield();
+            }
+        }
+
+        batch->tokens.clear();
+        batch->listing_ends.clear();
+        std::string &listing = m_lexer.getListing();
+
+        bool is_last_batch = false;
+        while (batch->tokens.size() < kBatchSize && !is_last_batch) {
+            batch->tokens.emplace_back();
+            Token &token = batch->tokens.back();
+            m_lexer.next(token);
+            batch->listing_ends.push_back(static_cast<uint32_t>(listing.size()));
+
+            is_last_batch = token.kind == TokenKind::kEndOfInput ||
+                            token.kind == TokenKind::kBadCharacter;
+        }
+
+        // the batch takes the listing; the lexer goes on with the storage
+        // the batch had last time
+        batch->listing.swap(listing);
+        listing.clear();
+        m_batches.push();
+
+        if (is_last_batch) {
+            return;
+        }
+    }
+}
+
+void ThreadedLexer::next(Token &p_token) {
+    // the end of input repeats, as with FastLexer
+    if (m_is_at_end) {
+        p_token = m_batch->tokens.back();
+        m_listing = std::string_view();
+        return;
+    }
+
+    if (m_batch != nullptr && m_index == m_batch->tokens.size()) {
+        m_batches.pop();
+        m_batch = nullptr;
+    }
+    for (int spins = 0; m_batch == nullptr; ++spins) {
+        m_batch = m_batches.getFrontSlot();
+        m_index = 0;
+        if (m_batch == nullptr && spins >= kNumOfSpins) {
+            std::this_thread::yield();
+        }
+    }
+
+    const uint32_t listing_begin =
+        (m_index == 0) ? 0 : m_batch->listing_ends[m_index - 1];
+    m_listing = std::string_view(m_batch->listing)
+                    .substr(listing_begin,
+                            m_batch->listing_ends[m_index] - listing_begin);
+    p_token = m_batch->tokens[m_index];
+    ++m_index;
+    m_is_at_end = p_token.kind == TokenKind::kEndOfInput;
+}
+
+bool ThreadedLexer::getDumpSymbolTable() {
+    join();
+    return m_lexer.getDumpSymbolTable();
+}
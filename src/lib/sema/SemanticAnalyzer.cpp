@@ -1,7 +1,48 @@
 #include "sema/SemanticAnalyzer.hpp"
 #include "visitor/AstNodeInclude.hpp"
 
-void SemanticAnalyzer::visit(ProgramNode &p_program)
+static bool isScalarType(const TypeId type)
+{
+    return type == TypeContext::kIntegerType || type == TypeContext::kRealType ||
+           type == TypeContext::kBoolType || type == TypeContext::kStringType;
+}
+
+void SemanticAnalyzer::pushExpressionEntry(ExpressionNode &p_expression, const SymbolEntry &p_entry)
+{
+    if (p_entry.kind != ConstantType && p_entry.attr_str == "error")
+    {
+        p_expression.setResultType(TypeContext::kNoType);
+    }
+    else
+    {
+        p_expression.setResultType(p_entry.type);
+    }
+
+    child_entries_stack.push(p_entry);
+}
+
+void SemanticAnalyzer::pushExpressionEntry(VariableReferenceNode &p_variable_ref, const SymbolEntry &p_entry)
+{
+    // the entry of a symbol of another kind has its declaration too
+    const AstNode *declaration = p_entry.declaration;
+    if (declaration != nullptr && declaration->getKind() == AstNodeKind::kVariable)
+    {
+        p_variable_ref.setVariable(static_cast<const VariableNode *>(declaration));
+    }
+    pushExpressionEntry(static_cast<ExpressionNode &>(p_variable_ref), p_entry);
+}
+
+void SemanticAnalyzer::pushExpressionEntry(FunctionInvocationNode &p_func_invocation, const SymbolEntry &p_entry)
+{
+    const AstNode *declaration = p_entry.declaration;
+    if (declaration != nullptr && declaration->getKind() == AstNodeKind::kFunction)
+    {
+        p_func_invocation.setFunction(static_cast<const FunctionNode *>(declaration));
+    }
+    pushExpressionEntry(static_cast<ExpressionNode &>(p_func_invocation), p_entry);
+}
+
+void SemanticAnalyzer::preVisit(ProgramNode &p_program)
 {
     /*
      * TODO:
@@ -14,35 +55,41 @@ void SemanticAnalyzer::visit(ProgramNode &p_program)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
+    beginProgram(p_program.getName(), p_program.getLocation());
+}
+
+void SemanticAnalyzer::postVisit(ProgramNode &p_program)
+{
+    endProgram();
+
+    printErrorMessages();
+}
+
+void SemanticAnalyzer::beginProgram(const Atom p_name, const Location &p_location)
+{
     pushScope();
 
     SymbolEntry program_entry;
-    program_entry.name = p_program.getNameCString();
+    program_entry.name = p_name;
     program_entry.kind = ProgramType;
     program_entry.level = 0;
-    program_entry.type = "void";
+    program_entry.type = TypeContext::kVoidType;
     program_entry.attr_str = "";
-    program_entry.line = p_program.getLocation().line;
-    program_entry.column = p_program.getLocation().col;
+    program_entry.line = p_location.line;
+    program_entry.column = p_location.col;
     insert(program_entry);
 
     parent_entries_stack.push_back(program_entry);
+}
 
-    p_program.visitChildNodes(*this);
-
+void SemanticAnalyzer::endProgram()
+{
     parent_entries_stack.pop_back();
 
     popScope();
-
-    printErrorMessages();
-}
-
-void SemanticAnalyzer::visit(DeclNode &p_decl)
-{
-    p_decl.visitChildNodes(*this);
 }
 
-void SemanticAnalyzer::visit(VariableNode &p_variable)
+void SemanticAnalyzer::postVisit(VariableNode &p_variable)
 {
     /*
      * TODO:
@@ -56,15 +103,14 @@ void SemanticAnalyzer::visit(VariableNode &p_variable)
      */
 
     SymbolEntry variable_entry;
-    variable_entry.name = p_variable.getNameCString();
+    variable_entry.name = p_variable.getName();
 
     variable_entry.level = getScopeLevel();
-    variable_entry.type = p_variable.getTypeCString();
+    variable_entry.type = p_variable.getType();
     variable_entry.attr_str = "";
     variable_entry.line = p_variable.getLocation().line;
     variable_entry.column = p_variable.getLocation().col;
-
-    p_variable.visitChildNodes(*this);
+    variable_entry.declaration = &p_variable;
 
     if (!child_entries_stack.empty() && child_entries_stack.top().kind == PropagateType)
     {
@@ -85,36 +131,19 @@ void SemanticAnalyzer::visit(VariableNode &p_variable)
         variable_entry.kind = VariableType;
     }
 
-    std::stringstream ss(variable_entry.type);
-    std::string arr, dim_str;
-    getline(ss, arr, ' ');
-    if (getline(ss, arr))
+    for (const uint64_t dimension : getPType(variable_entry.type).getDimensions())
     {
-        for (size_t i = 0; i < arr.size(); i++)
+        if (dimension == 0)
         {
-            if (arr[i] == '[')
-            {
-                dim_str.clear();
-            }
-            else if (arr[i] == ']')
-            {
-                if (std::stoi(dim_str) <= 0)
-                {
-                    // dimension error
-                    variable_entry.attr_str = "error";
-
-                    std::string error_message = "";
-                    error_message += "'";
-                    error_message += variable_entry.name;
-                    error_message += "' declared as an array with an index that is not greater than 0";
-                    listErrorMessage(variable_entry.line, variable_entry.column, error_message);
-                    break;
-                }
-            }
-            else
-            {
-                dim_str += arr[i];
-            }
+            // dimension error
+            variable_entry.attr_str = "error";
+
+            std::string error_message = "";
+            error_message += "'";
+            error_message += variable_entry.getNameCString();
+            error_message += "' declared as an array with an index that is not greater than 0";
+            listErrorMessage(variable_entry.line, variable_entry.column, error_message);
+            break;
         }
     }
 
@@ -125,7 +154,7 @@ void SemanticAnalyzer::visit(VariableNode &p_variable)
     }
 }
 
-void SemanticAnalyzer::visit(ConstantValueNode &p_constant_value)
+void SemanticAnalyzer::postVisit(ConstantValueNode &p_constant_value)
 {
     /*
      * TODO:
@@ -138,36 +167,19 @@ void SemanticAnalyzer::visit(ConstantValueNode &p_constant_value)
      * 5. Pop the symbol table pushed at the 1st step.
      */
     SymbolEntry propagate_entry;
-    propagate_entry.name = "";
+    propagate_entry.name = StringInterner::kEmptyAtom;
     propagate_entry.kind = PropagateType;
     propagate_entry.level = getScopeLevel();
     propagate_entry.attr_str = p_constant_value.getConstantValueCString();
     propagate_entry.line = p_constant_value.getLocation().line;
     propagate_entry.column = p_constant_value.getLocation().col;
 
-    PType::PrimitiveTypeEnum constant_type = p_constant_value.getTypeSharedPtr()->getPrimitiveType();
-
-    switch (constant_type)
-    {
-    case PType::PrimitiveTypeEnum::kIntegerType:
-        propagate_entry.type = "integer";
-        break;
-    case PType::PrimitiveTypeEnum::kRealType:
-        propagate_entry.type = "real";
-        break;
-    case PType::PrimitiveTypeEnum::kBoolType:
-        propagate_entry.type = "boolean";
-        break;
-    case PType::PrimitiveTypeEnum::kStringType:
-        propagate_entry.type = "string";
-        break;
-    default:;
-    }
+    propagate_entry.type = p_constant_value.getType();
 
-    child_entries_stack.push(propagate_entry);
+    pushExpressionEntry(p_constant_value, propagate_entry);
 }
 
-void SemanticAnalyzer::visit(FunctionNode &p_function)
+void SemanticAnalyzer::preVisit(FunctionNode &p_function)
 {
     /*
      * TODO:
@@ -181,16 +193,31 @@ void SemanticAnalyzer::visit(FunctionNode &p_function)
      */
 
     SymbolEntry function_entry;
-    function_entry.name = p_function.getNameCString();
+    function_entry.name = p_function.getName();
     function_entry.kind = FunctionType;
     function_entry.level = getScopeLevel();
     function_entry.attr_str = "";
     function_entry.line = p_function.getLocation().line;
     function_entry.column = p_function.getLocation().col;
+    if (functionsRetained)
+    {
+        function_entry.declaration = &p_function;
+    }
 
+    function_entry.type = p_function.getReturnType();
+    for (const auto &parameter : p_function.getParameters())
+    {
+        for (const auto &variable : parameter->getVariables())
+        {
+            function_entry.parameter_types.push_back(variable->getType());
+        }
+    }
+
+    // the parameter types of "<return type> (<parameter types>)"
     std::string proto_type = p_function.getPrototypeCString();
     std::stringstream ss(proto_type);
-    std::getline(ss, function_entry.type, ' ');
+    std::string return_type;
+    std::getline(ss, return_type, ' ');
     std::getline(ss, function_entry.attr_str);
     if (function_entry.attr_str.size() > 2)
     {
@@ -206,15 +233,16 @@ void SemanticAnalyzer::visit(FunctionNode &p_function)
     pushScope();
 
     parent_entries_stack.push_back(function_entry);
+}
 
-    p_function.visitChildNodes(*this);
-
+void SemanticAnalyzer::postVisit(FunctionNode &p_function)
+{
     parent_entries_stack.pop_back();
 
     popScope();
 }
 
-void SemanticAnalyzer::visit(CompoundStatementNode &p_compound_statement)
+void SemanticAnalyzer::preVisit(CompoundStatementNode &p_compound_statement)
 {
     /*
      * TODO:
@@ -233,10 +261,10 @@ void SemanticAnalyzer::visit(CompoundStatementNode &p_compound_statement)
     }
 
     SymbolEntry compound_statement_entry;
-    compound_statement_entry.name = "";
+    compound_statement_entry.name = StringInterner::kEmptyAtom;
     compound_statement_entry.kind = CompoundStatementType;
     compound_statement_entry.level = getScopeLevel();
-    compound_statement_entry.type = "void";
+    compound_statement_entry.type = TypeContext::kVoidType;
     compound_statement_entry.attr_str = "";
 
     if (addScope)
@@ -245,18 +273,20 @@ void SemanticAnalyzer::visit(CompoundStatementNode &p_compound_statement)
     }
 
     parent_entries_stack.push_back(compound_statement_entry);
+}
 
-    p_compound_statement.visitChildNodes(*this);
-
+void SemanticAnalyzer::postVisit(CompoundStatementNode &p_compound_statement)
+{
     parent_entries_stack.pop_back();
 
-    if (addScope)
+    // the parent is on top again, which told preVisit() whether to add one
+    if (parent_entries_stack.back().kind != FunctionType)
     {
         popScope();
     }
 }
 
-void SemanticAnalyzer::visit(PrintNode &p_print)
+void SemanticAnalyzer::postVisit(PrintNode &p_print)
 {
     /*
      * TODO:
@@ -269,8 +299,6 @@ void SemanticAnalyzer::visit(PrintNode &p_print)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
-    p_print.visitChildNodes(*this);
-
     SymbolEntry expression_entry = child_entries_stack.top();
     child_entries_stack.pop();
 
@@ -280,8 +308,7 @@ void SemanticAnalyzer::visit(PrintNode &p_print)
         return;
     }
 
-    if (expression_entry.type != "integer" && expression_entry.type != "real" &&
-        expression_entry.type != "boolean" && expression_entry.type != "string")
+    if (!isScalarType(expression_entry.type))
     {
         // error
         std::string error_message = "expression of print statement must be scalar type";
@@ -289,7 +316,7 @@ void SemanticAnalyzer::visit(PrintNode &p_print)
     }
 }
 
-void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op)
+void SemanticAnalyzer::postVisit(BinaryOperatorNode &p_bin_op)
 {
     /*
      * TODO:
@@ -302,8 +329,6 @@ void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
-    p_bin_op.visitChildNodes(*this);
-
     SymbolEntry right_operand_entry = child_entries_stack.top();
     child_entries_stack.pop();
     SymbolEntry left_operand_entry = child_entries_stack.top();
@@ -311,7 +336,7 @@ void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op)
     std::string operator_string = p_bin_op.getOpCString();
 
     SymbolEntry expression_entry;
-    expression_entry.name = "";
+    expression_entry.name = StringInterner::kEmptyAtom;
     expression_entry.kind = PropagateType;
     expression_entry.level = getScopeLevel();
     expression_entry.attr_str = "";
@@ -321,30 +346,30 @@ void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op)
     if ((left_operand_entry.kind != ConstantType && left_operand_entry.attr_str == "error") || (right_operand_entry.kind != ConstantType && right_operand_entry.attr_str == "error"))
     {
         // no need of semantic analysis
-        expression_entry.type = "";
+        expression_entry.type = TypeContext::kNoType;
         expression_entry.attr_str = "error";
-        child_entries_stack.push(expression_entry);
+        pushExpressionEntry(p_bin_op, expression_entry);
         return;
     }
 
     bool detect_error = false;
     if (operator_string == "+" || operator_string == "-" || operator_string == "*" || operator_string == "/")
     {
-        if (left_operand_entry.type == "integer" && right_operand_entry.type == "integer")
+        if (left_operand_entry.type == TypeContext::kIntegerType && right_operand_entry.type == TypeContext::kIntegerType)
         {
-            expression_entry.type = "integer";
+            expression_entry.type = TypeContext::kIntegerType;
         }
-        else if ((left_operand_entry.type == "real" && right_operand_entry.type == "integer") ||
-                 (left_operand_entry.type == "integer" && right_operand_entry.type == "real") ||
-                 (left_operand_entry.type == "real" && right_operand_entry.type == "real"))
+        else if ((left_operand_entry.type == TypeContext::kRealType && right_operand_entry.type == TypeContext::kIntegerType) ||
+                 (left_operand_entry.type == TypeContext::kIntegerType && right_operand_entry.type == TypeContext::kRealType) ||
+                 (left_operand_entry.type == TypeContext::kRealType && right_operand_entry.type == TypeContext::kRealType))
         {
-            expression_entry.type = "real";
+            expression_entry.type = TypeContext::kRealType;
         }
         else if (operator_string == "+" &&
-                 left_operand_entry.type == "string" &&
-                 right_operand_entry.type == "string")
+                 left_operand_entry.type == TypeContext::kStringType &&
+                 right_operand_entry.type == TypeContext::kStringType)
         {
-            expression_entry.type = "string";
+            expression_entry.type = TypeContext::kStringType;
         }
         else
         {
@@ -354,9 +379,9 @@ void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op)
     }
     else if (operator_string == "mod")
     {
-        if (left_operand_entry.type == "integer" && right_operand_entry.type == "integer")
+        if (left_operand_entry.type == TypeContext::kIntegerType && right_operand_entry.type == TypeContext::kIntegerType)
         {
-            expression_entry.type = "integer";
+            expression_entry.type = TypeContext::kIntegerType;
         }
         else
         {
@@ -366,9 +391,9 @@ void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op)
     }
     else if (operator_string == "and" || operator_string == "or")
     {
-        if (left_operand_entry.type == "boolean" && right_operand_entry.type == "boolean")
+        if (left_operand_entry.type == TypeContext::kBoolType && right_operand_entry.type == TypeContext::kBoolType)
         {
-            expression_entry.type = "boolean";
+            expression_entry.type = TypeContext::kBoolType;
         }
         else
         {
@@ -378,12 +403,12 @@ void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op)
     }
     else // relation operator "<" "<=" "=" "=>" ">" "<>"
     {
-        if ((left_operand_entry.type == "integer" && right_operand_entry.type == "integer") ||
-            (left_operand_entry.type == "real" && right_operand_entry.type == "integer") ||
-            (left_operand_entry.type == "integer" && right_operand_entry.type == "real") ||
-            (left_operand_entry.type == "real" && right_operand_entry.type == "real"))
+        if ((left_operand_entry.type == TypeContext::kIntegerType && right_operand_entry.type == TypeContext::kIntegerType) ||
+            (left_operand_entry.type == TypeContext::kRealType && right_operand_entry.type == TypeContext::kIntegerType) ||
+            (left_operand_entry.type == TypeContext::kIntegerType && right_operand_entry.type == TypeContext::kRealType) ||
+            (left_operand_entry.type == TypeContext::kRealType && right_operand_entry.type == TypeContext::kRealType))
         {
-            expression_entry.type = "boolean";
+            expression_entry.type = TypeContext::kBoolType;
         }
         else
         {
@@ -394,20 +419,20 @@ void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op)
 
     if (detect_error)
     {
-        expression_entry.type = "";
+        expression_entry.type = TypeContext::kNoType;
         expression_entry.attr_str = "error";
 
         std::string error_message = "";
         error_message += "invalid operands to binary operator '" + operator_string + "' ";
-        error_message += "('" + left_operand_entry.type + "' and";
-        error_message += " '" + right_operand_entry.type + "')";
+        error_message += "('" + std::string(getTypeCString(left_operand_entry.type)) + "' and";
+        error_message += " '" + std::string(getTypeCString(right_operand_entry.type)) + "')";
         listErrorMessage(expression_entry.line, expression_entry.column, error_message);
     }
 
-    child_entries_stack.push(expression_entry);
+    pushExpressionEntry(p_bin_op, expression_entry);
 }
 
-void SemanticAnalyzer::visit(UnaryOperatorNode &p_un_op)
+void SemanticAnalyzer::postVisit(UnaryOperatorNode &p_un_op)
 {
     /*
      * TODO:
@@ -420,14 +445,12 @@ void SemanticAnalyzer::visit(UnaryOperatorNode &p_un_op)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
-    p_un_op.visitChildNodes(*this);
-
     SymbolEntry operand_entry = child_entries_stack.top();
     child_entries_stack.pop();
     std::string operator_string = p_un_op.getOpCString();
 
     SymbolEntry expression_entry;
-    expression_entry.name = "";
+    expression_entry.name = StringInterner::kEmptyAtom;
     expression_entry.kind = PropagateType;
     expression_entry.level = getScopeLevel();
     expression_entry.attr_str = "";
@@ -437,13 +460,13 @@ void SemanticAnalyzer::visit(UnaryOperatorNode &p_un_op)
     bool detect_error = false;
     if (operator_string == "neg")
     {
-        if (operand_entry.type == "integer")
+        if (operand_entry.type == TypeContext::kIntegerType)
         {
-            expression_entry.type = "integer";
+            expression_entry.type = TypeContext::kIntegerType;
         }
-        else if (operand_entry.type == "real")
+        else if (operand_entry.type == TypeContext::kRealType)
         {
-            expression_entry.type = "real";
+            expression_entry.type = TypeContext::kRealType;
         }
         else
         {
@@ -453,9 +476,9 @@ void SemanticAnalyzer::visit(UnaryOperatorNode &p_un_op)
     }
     else if (operator_string == "not")
     {
-        if (operand_entry.type == "boolean")
+        if (operand_entry.type == TypeContext::kBoolType)
         {
-            expression_entry.type = "boolean";
+            expression_entry.type = TypeContext::kBoolType;
         }
         else
         {
@@ -466,19 +489,19 @@ void SemanticAnalyzer::visit(UnaryOperatorNode &p_un_op)
 
     if (detect_error)
     {
-        expression_entry.type = "";
+        expression_entry.type = TypeContext::kNoType;
         expression_entry.attr_str = "error";
 
         std::string error_message = "";
         error_message += "invalid operand to unary operator '" + operator_string + "' ";
-        error_message += "('" + operand_entry.type + "')";
+        error_message += "('" + std::string(getTypeCString(operand_entry.type)) + "')";
         listErrorMessage(expression_entry.line, expression_entry.column, error_message);
     }
 
-    child_entries_stack.push(expression_entry);
+    pushExpressionEntry(p_un_op, expression_entry);
 }
 
-void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation)
+void SemanticAnalyzer::postVisit(FunctionInvocationNode &p_func_invocation)
 {
     /*
      * TODO:
@@ -491,10 +514,11 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
-    p_func_invocation.visitChildNodes(*this);
-
     SymbolEntry function_entry;
-    function_entry.name = p_func_invocation.getNameCString();
+    function_entry.name = p_func_invocation.getName();
+    // where lookup() reports an undeclared name
+    function_entry.line = p_func_invocation.getLocation().line;
+    function_entry.column = p_func_invocation.getLocation().col;
 
     size_t narg = p_func_invocation.getNumOfArguments();
     size_t npar;
@@ -507,13 +531,13 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation)
             child_entries_stack.pop();
         }
 
-        function_entry.name = p_func_invocation.getNameCString();
+        function_entry.name = p_func_invocation.getName();
         function_entry.kind = FunctionType;
-        function_entry.type = "";
+        function_entry.type = TypeContext::kNoType;
         function_entry.attr_str = "error";
         function_entry.line = p_func_invocation.getLocation().line;
         function_entry.column = p_func_invocation.getLocation().col;
-        child_entries_stack.push(function_entry);
+        pushExpressionEntry(p_func_invocation, function_entry);
 
         return;
     }
@@ -521,7 +545,9 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation)
     {
         // error
         std::string error_message = "";
-        error_message += "call of non-function symbol '" + function_entry.name + "'";
+        error_message += "call of non-function symbol '";
+        error_message += function_entry.getNameCString();
+        error_message += "'";
         listErrorMessage(p_func_invocation.getLocation().line, p_func_invocation.getLocation().col, error_message);
 
         for (size_t i = 0; i < narg; i++)
@@ -531,34 +557,20 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation)
         function_entry.attr_str = "error";
         function_entry.line = p_func_invocation.getLocation().line;
         function_entry.column = p_func_invocation.getLocation().col;
-        child_entries_stack.push(function_entry);
+        pushExpressionEntry(p_func_invocation, function_entry);
         return;
     }
     else
     {
-        std::string function_prototype = function_entry.attr_str;
-
-        if (function_prototype.empty())
-        {
-            npar = 0;
-        }
-        else
-        {
-            npar = 1;
-            for (size_t i = 0; i < function_prototype.size(); i++)
-            {
-                if (function_prototype[i] == ',')
-                {
-                    npar++;
-                }
-            }
-        }
+        npar = function_entry.parameter_types.size();
 
         if (narg != npar)
         {
             // error
             std::string error_message = "";
-            error_message += "too few/much arguments provided for function '" + function_entry.name + "'";
+            error_message += "too few/much arguments provided for function '";
+            error_message += function_entry.getNameCString();
+            error_message += "'";
             listErrorMessage(p_func_invocation.getLocation().line, p_func_invocation.getLocation().col, error_message);
 
             for (size_t i = 0; i < narg; i++)
@@ -568,7 +580,7 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation)
             function_entry.attr_str = "error";
             function_entry.line = p_func_invocation.getLocation().line;
             function_entry.column = p_func_invocation.getLocation().col;
-            child_entries_stack.push(function_entry);
+            pushExpressionEntry(p_func_invocation, function_entry);
             return;
         }
     }
@@ -576,31 +588,18 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation)
     if (narg == 0)
     {
         function_entry.level = getScopeLevel();
-        child_entries_stack.push(function_entry);
+        pushExpressionEntry(p_func_invocation, function_entry);
         return;
     }
 
-    std::string scalar_type = function_entry.type;
-    std::string arr = function_entry.attr_str;
-
-    std::stringstream ss(arr);
-    std::vector<std::string> parameters_type;
-    parameters_type.resize(npar);
-    for (size_t i = 0; i < npar; i++)
-    {
-        getline(ss, parameters_type[i], ',');
-        if (parameters_type[i][0] == ' ')
-        {
-            parameters_type[i] = parameters_type[i].substr(1, parameters_type[i].size() - 1);
-        }
-    }
+    const std::vector<TypeId> &parameters_type = function_entry.parameter_types;
 
     std::vector<size_t> arg_line, arg_col;
-    std::vector<std::string> arguments_type;
+    std::vector<TypeId> arguments_type;
     arg_line.resize(narg);
     arg_col.resize(narg);
     arguments_type.resize(narg);
-    for (size_t i = arguments_type.size() - 1; i >= 0; i--)
+    for (size_t i = narg; i-- > 0;)
     {
         arg_line[i] = child_entries_stack.top().line;
         arg_col[i] = child_entries_stack.top().column;
@@ -610,13 +609,13 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation)
 
     for (size_t i = 0; i < narg; i++)
     {
-        if (arguments_type[i] != parameters_type[i] ||
-            !(arguments_type[i] == "integer" && parameters_type[i] == "real"))
+        if (arguments_type[i] != parameters_type[i] &&
+            !(arguments_type[i] == TypeContext::kIntegerType && parameters_type[i] == TypeContext::kRealType))
         {
             // error
             std::string error_message = "";
-            error_message += "incompatible type passing '" + arguments_type[i] + "' ";
-            error_message += "to parameter of type '" + parameters_type[i] + "'";
+            error_message += "incompatible type passing '" + std::string(getTypeCString(arguments_type[i])) + "' ";
+            error_message += "to parameter of type '" + std::string(getTypeCString(parameters_type[i])) + "'";
             listErrorMessage(arg_line[i], arg_col[i], error_message);
 
             function_entry.attr_str = "error";
@@ -625,10 +624,10 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation)
     }
 
     function_entry.level = getScopeLevel();
-    child_entries_stack.push(function_entry);
+    pushExpressionEntry(p_func_invocation, function_entry);
 }
 
-void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref)
+void SemanticAnalyzer::postVisit(VariableReferenceNode &p_variable_ref)
 {
     /*
      * TODO:
@@ -641,10 +640,8 @@ void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
-    p_variable_ref.visitChildNodes(*this);
-
     SymbolEntry variable_entry;
-    variable_entry.name = p_variable_ref.getNameCString();
+    variable_entry.name = p_variable_ref.getName();
     variable_entry.line = p_variable_ref.getLocation().line;
     variable_entry.column = p_variable_ref.getLocation().col;
 
@@ -658,7 +655,9 @@ void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref)
     {
         // error
         std::string error_message = "";
-        error_message += "use of non-variable symbol '" + variable_entry.name + "'";
+        error_message += "use of non-variable symbol '";
+        error_message += variable_entry.getNameCString();
+        error_message += "'";
         listErrorMessage(p_variable_ref.getLocation().line, p_variable_ref.getLocation().col, error_message);
 
         variable_entry.attr_str = "error";
@@ -672,26 +671,14 @@ void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref)
             child_entries_stack.pop();
         }
 
-        child_entries_stack.push(variable_entry);
+        pushExpressionEntry(p_variable_ref, variable_entry);
         return;
     }
 
     size_t ref_ndim = p_variable_ref.getNumOfDim();
 
-    std::stringstream ss(variable_entry.type);
-    std::string scalar_type, arr;
-    size_t var_ndim = 0;
-    getline(ss, scalar_type, ' ');
-    if (getline(ss, arr))
-    {
-        for (size_t i = 0; i < arr.size(); i++)
-        {
-            if (arr[i] == '[')
-            {
-                var_ndim++;
-            }
-        }
-    }
+    const PType &variable_type = getPType(variable_entry.type);
+    size_t var_ndim = variable_type.getNumOfDimensions();
 
     SymbolEntry expression_entry;
     bool invalid_index = false;
@@ -701,7 +688,7 @@ void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref)
         expression_entry = child_entries_stack.top();
         child_entries_stack.pop();
 
-        if (expression_entry.type != "integer")
+        if (expression_entry.type != TypeContext::kIntegerType)
         {
             invalid_index = true;
             invalid_index_line = expression_entry.line;
@@ -715,7 +702,7 @@ void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref)
         listErrorMessage(invalid_index_line, invalid_index_column, error_message);
 
         variable_entry.attr_str = "error";
-        child_entries_stack.push(variable_entry);
+        pushExpressionEntry(p_variable_ref, variable_entry);
         return;
     }
 
@@ -723,46 +710,39 @@ void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref)
     {
         // error
         std::string error_message = "";
-        error_message += "there is an over array subscript on '" + variable_entry.name + "'";
+        error_message += "there is an over array subscript on '";
+        error_message += variable_entry.getNameCString();
+        error_message += "'";
         listErrorMessage(p_variable_ref.getLocation().line, p_variable_ref.getLocation().col, error_message);
 
         variable_entry.attr_str = "error";
-        child_entries_stack.push(variable_entry);
+        pushExpressionEntry(p_variable_ref, variable_entry);
     }
     else if (ref_ndim == var_ndim)
     {
         variable_entry.level = getScopeLevel();
-        variable_entry.type = scalar_type;
+        variable_entry.type = variable_type.getElementType();
         variable_entry.line = p_variable_ref.getLocation().line;
         variable_entry.column = p_variable_ref.getLocation().col;
-        child_entries_stack.push(variable_entry);
+        pushExpressionEntry(p_variable_ref, variable_entry);
     }
     else // ref_ndim < var_ndim
     {
         variable_entry.level = getScopeLevel();
 
-        size_t dim_diff = var_ndim - ref_ndim;
-        size_t sub_arr_idx;
-        std::string sub_arr;
-        for (size_t i = variable_entry.type.size(); i >= 0 && dim_diff > 0; i--)
+        // each index drops the first dimension
+        for (size_t i = 0; i < ref_ndim; i++)
         {
-            if (variable_entry.type[i] == '[' || variable_entry.type[i] == ' ')
-            {
-                dim_diff--;
-                sub_arr_idx = i;
-            }
+            variable_entry.type = getPType(variable_entry.type).getSubArrayType();
         }
 
-        sub_arr = variable_entry.type.substr(sub_arr_idx, variable_entry.type.size() - sub_arr_idx);
-        variable_entry.type = scalar_type + " " + sub_arr;
-
         variable_entry.line = p_variable_ref.getLocation().line;
         variable_entry.column = p_variable_ref.getLocation().col;
-        child_entries_stack.push(variable_entry);
+        pushExpressionEntry(p_variable_ref, variable_entry);
     }
 }
 
-void SemanticAnalyzer::visit(AssignmentNode &p_assignment)
+void SemanticAnalyzer::postVisit(AssignmentNode &p_assignment)
 {
     /*
      * TODO:
@@ -775,8 +755,6 @@ void SemanticAnalyzer::visit(AssignmentNode &p_assignment)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
-    p_assignment.visitChildNodes(*this);
-
     SymbolEntry expression_entry = child_entries_stack.top();
     child_entries_stack.pop();
     SymbolEntry variable_reference_entry = child_entries_stack.top();
@@ -789,8 +767,7 @@ void SemanticAnalyzer::visit(AssignmentNode &p_assignment)
     }
     else
     {
-        if (variable_reference_entry.type != "integer" && variable_reference_entry.type != "real" &&
-            variable_reference_entry.type != "boolean" && variable_reference_entry.type != "string")
+        if (!isScalarType(variable_reference_entry.type))
         {
             // error
             std::string error_message = "array assignment is not allowed";
@@ -802,7 +779,9 @@ void SemanticAnalyzer::visit(AssignmentNode &p_assignment)
         {
             // error
             std::string error_message = "";
-            error_message += "cannot assign to variable '" + variable_reference_entry.name + "' which is a constant";
+            error_message += "cannot assign to variable '";
+            error_message += variable_reference_entry.getNameCString();
+            error_message += "' which is a constant";
             listErrorMessage(variable_reference_entry.line, variable_reference_entry.column, error_message);
 
             return;
@@ -824,20 +803,19 @@ void SemanticAnalyzer::visit(AssignmentNode &p_assignment)
     }
     else
     {
-        if (expression_entry.type != "integer" && expression_entry.type != "real" &&
-            expression_entry.type != "boolean" && expression_entry.type != "string")
+        if (!isScalarType(expression_entry.type))
         {
             // error
             std::string error_message = "array assignment is not allowed";
             listErrorMessage(expression_entry.line, expression_entry.column, error_message);
         }
         else if (variable_reference_entry.type != expression_entry.type &&
-                 !(variable_reference_entry.type == "real" && expression_entry.type == "integer"))
+                 !(variable_reference_entry.type == TypeContext::kRealType && expression_entry.type == TypeContext::kIntegerType))
         {
             // error
             std::string error_message = "";
-            error_message += "assigning to '" + variable_reference_entry.type + "' ";
-            error_message += "from incompatible type '" + expression_entry.type + "'";
+            error_message += "assigning to '" + std::string(getTypeCString(variable_reference_entry.type)) + "' ";
+            error_message += "from incompatible type '" + std::string(getTypeCString(expression_entry.type)) + "'";
             listErrorMessage(p_assignment.getLocation().line, p_assignment.getLocation().col, error_message);
         }
     }
@@ -848,7 +826,7 @@ void SemanticAnalyzer::visit(AssignmentNode &p_assignment)
     }
 }
 
-void SemanticAnalyzer::visit(ReadNode &p_read)
+void SemanticAnalyzer::postVisit(ReadNode &p_read)
 {
     /*
      * TODO:
@@ -860,8 +838,6 @@ void SemanticAnalyzer::visit(ReadNode &p_read)
      * 4. Perform semantic analyses of this node.
      * 5. Pop the symbol table pushed at the 1st step.
      */
-    p_read.visitChildNodes(*this);
-
     SymbolEntry variable_reference_entry = child_entries_stack.top();
     child_entries_stack.pop();
 
@@ -871,8 +847,7 @@ void SemanticAnalyzer::visit(ReadNode &p_read)
         return;
     }
 
-    if (variable_reference_entry.type != "integer" && variable_reference_entry.type != "real" &&
-        variable_reference_entry.type != "boolean" && variable_reference_entry.type != "string")
+    if (!isScalarType(variable_reference_entry.type))
     {
         // error
         std::string error_message = "variable reference of read statement must be scalar type";
@@ -886,7 +861,7 @@ void SemanticAnalyzer::visit(ReadNode &p_read)
     }
 }
 
-void SemanticAnalyzer::visit(IfNode &p_if)
+void SemanticAnalyzer::postVisit(IfNode &p_if)
 {
     /*
      * TODO:
@@ -899,8 +874,6 @@ void SemanticAnalyzer::visit(IfNode &p_if)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
-    p_if.visitChildNodes(*this);
-
     SymbolEntry expression_entry = child_entries_stack.top();
     child_entries_stack.pop();
 
@@ -910,7 +883,7 @@ void SemanticAnalyzer::visit(IfNode &p_if)
         return;
     }
 
-    if (expression_entry.type != "boolean")
+    if (expression_entry.type != TypeContext::kBoolType)
     {
         // error
         std::string error_message = "the expression of condition must be boolean type";
@@ -918,7 +891,7 @@ void SemanticAnalyzer::visit(IfNode &p_if)
     }
 }
 
-void SemanticAnalyzer::visit(WhileNode &p_while)
+void SemanticAnalyzer::postVisit(WhileNode &p_while)
 {
     /*
      * TODO:
@@ -931,12 +904,10 @@ void SemanticAnalyzer::visit(WhileNode &p_while)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
-    p_while.visitChildNodes(*this);
-
     SymbolEntry expression_entry = child_entries_stack.top();
     child_entries_stack.pop();
 
-    if (expression_entry.type != "boolean")
+    if (expression_entry.type != TypeContext::kBoolType)
     {
         // error
         std::string error_message = "the expression of condition must be boolean type";
@@ -944,7 +915,7 @@ void SemanticAnalyzer::visit(WhileNode &p_while)
     }
 }
 
-void SemanticAnalyzer::visit(ForNode &p_for)
+void SemanticAnalyzer::preVisit(ForNode &p_for)
 {
     /*
      * TODO:
@@ -957,18 +928,19 @@ void SemanticAnalyzer::visit(ForNode &p_for)
      * 5. Pop the symbol table pushed at the 1st step.
      */
     SymbolEntry for_loop_entry;
-    for_loop_entry.name = "";
+    for_loop_entry.name = StringInterner::kEmptyAtom;
     for_loop_entry.kind = ForLoopType;
     for_loop_entry.level = getScopeLevel();
-    for_loop_entry.type = "void";
+    for_loop_entry.type = TypeContext::kVoidType;
     for_loop_entry.attr_str = "";
 
     pushScope();
 
     parent_entries_stack.push_back(for_loop_entry);
+}
 
-    p_for.visitChildNodes(*this);
-
+void SemanticAnalyzer::postVisit(ForNode &p_for)
+{
     parent_entries_stack.pop_back();
 
     SymbolEntry loop_variable_entry = loop_table.back();
@@ -987,7 +959,7 @@ void SemanticAnalyzer::visit(ForNode &p_for)
     popScope();
 }
 
-void SemanticAnalyzer::visit(ReturnNode &p_return)
+void SemanticAnalyzer::postVisit(ReturnNode &p_return)
 {
     /*
      * TODO:
@@ -1000,8 +972,6 @@ void SemanticAnalyzer::visit(ReturnNode &p_return)
      * 5. Pop the symbol table pushed at the 1st step.
      */
 
-    p_return.visitChildNodes(*this);
-
     SymbolEntry expression_entry = child_entries_stack.top();
     child_entries_stack.pop();
 
@@ -1009,7 +979,7 @@ void SemanticAnalyzer::visit(ReturnNode &p_return)
     bool legal_region = false;
     for (const auto &parent_entry : parent_entries_stack)
     {
-        if (parent_entry.kind == FunctionType && parent_entry.type != "void")
+        if (parent_entry.kind == FunctionType && parent_entry.type != TypeContext::kVoidType)
         {
             legal_region = true;
             function_entry = parent_entry;
@@ -1031,12 +1001,12 @@ void SemanticAnalyzer::visit(ReturnNode &p_return)
     }
 
     if (function_entry.type != expression_entry.type &&
-        !(function_entry.type == "real" && expression_entry.type == "integer"))
+        !(function_entry.type == TypeContext::kRealType && expression_entry.type == TypeContext::kIntegerType))
     {
         // error
         std::string error_message = "";
-        error_message += "return '" + expression_entry.type + "' ";
-        error_message += "from a function with return type '" + function_entry.type + "'";
+        error_message += "return '" + std::string(getTypeCString(expression_entry.type)) + "' ";
+        error_message += "from a function with return type '" + std::string(getTypeCString(function_entry.type)) + "'";
         listErrorMessage(expression_entry.line, expression_entry.column, error_message);
     }
 }
@@ -0,0 +1,35 @@
+#include "util/Arena.hpp"
+
+void *Arena::allocateInNewBlock(const size_t p_size,
+                                const size_t p_alignment) {
+    // new[] aligns for any fundamental type; more is asked for seldom enough
+    // to just pad for it
+    const size_t padding =
+        (p_alignment > alignof(std::max_align_t)) ? p_alignment - 1 : 0;
+
+    if (p_size + padding > kBlockSize / 4) {
+        // large objects get a block of their own, so the current block is
+        // not wasted
+        m_blocks.emplace_back(new char[p_size + padding]);
+        const uintptr_t block =
+            reinterpret_cast<uintptr_t>(m_blocks.back().get());
+        return reinterpret_cast<void *>(
+            (block + p_alignment - 1) & ~(uintptr_t{p_alignment} - 1));
+    }
+
+    m_blocks.emplace_back(new char[kBlockSize]);
+    const uintptr_t block =
+        reinterpret_cast<uintptr_t>(m_blocks.back().get());
+    const uintptr_t start =
+        (block + p_alignment - 1) & ~(uintptr_t{p_alignment} - 1);
+    m_cursor = start + p_size;
+    m_end = block + kBlockSize;
+    return reinterpret_cast<void *>(start);
+}
+
+void Arena::rewind(const Mark &p_mark) {
+    // the block that p_mark.cursor is in predates the mark, so it stays
+    m_blocks.resize(p_mark.num_of_blocks);
+    m_cursor = p_mark.cursor;
+    m_end = p_mark.end;
+}
@@ -0,0 +1,37 @@
+#include "util/LineIndex.hpp"
+
+#include <cstring>
+
+void LineIndex::build() {
+    m_line_starts.push_back(0);
+
+    const char *const end = m_source + m_source_size;
+    for (const char *cursor = m_source; cursor != end; ++cursor) {
+        cursor = static_cast<const char *>(
+            std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        if (cursor == nullptr) {
+            break;
+        }
+        m_line_starts.push_back(static_cast<uint32_t>(cursor + 1 - m_source));
+    }
+    m_is_built = true;
+}
+
+size_t LineIndex::getNumOfLines() {
+    if (!m_is_built) {
+        build();
+    }
+    return m_line_starts.size();
+}
+
+std::string_view LineIndex::getLine(const uint32_t p_line) {
+    if (p_line == 0 || p_line > getNumOfLines()) {
+        return {};
+    }
+
+    const uint32_t start = m_line_starts[p_line - 1];
+    const size_t end = (p_line < m_line_starts.size())
+                           ? m_line_starts[p_line] - 1 // drop the newline
+                           : m_source_size;
+    return {m_source + start, end - start};
+}
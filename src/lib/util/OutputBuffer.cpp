@@ -0,0 +1,32 @@
+#include "util/OutputBuffer.hpp"
+
+#include <algorithm>
+
+void OutputBuffer::putSpaces(size_t p_num_of_spaces) {
+    while (p_num_of_spaces != 0) {
+        if (m_size == kCapacity) {
+            flush();
+        }
+        const size_t size = std::min(p_num_of_spaces, kCapacity - m_size);
+        std::memset(m_data.get() + m_size, ' ', size);
+        m_size += size;
+        p_num_of_spaces -= size;
+    }
+}
+
+void OutputBuffer::flush() {
+    if (m_size != 0) {
+        std::fwrite(m_data.get(), 1, m_size, m_file);
+        m_size = 0;
+    }
+}
+
+void OutputBuffer::writeLarge(const char *const p_data, const size_t p_size) {
+    flush();
+    if (p_size >= kCapacity) {
+        std::fwrite(p_data, 1, p_size, m_file);
+        return;
+    }
+    std::memcpy(m_data.get(), p_data, p_size);
+    m_size = p_size;
+}
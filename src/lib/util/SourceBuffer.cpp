@@ -0,0 +1,135 @@
+#include "util/SourceBuffer.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static size_t roundUpToPageSize(const size_t p_length) {
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (p_length + page_size - 1) / page_size * page_size;
+}
+
+SourceBuffer::~SourceBuffer() { release(); }
+
+void SourceBuffer::release() {
+    if (isMapped()) {
+        munmap(m_data, m_mapping_length);
+    } else {
+        std::free(m_data);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping_length = 0;
+}
+
+bool SourceBuffer::open(const char *const p_path, const bool p_use_mmap) {
+    release();
+
+    const int fd = ::open(p_path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat file_stat;
+    bool success = false;
+    if (p_use_mmap && fstat(fd, &file_stat) == 0 &&
+        S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+        success = map(fd, static_cast<size_t>(file_stat.st_size));
+    }
+    if (!success) {
+        success = read(fd);
+    }
+
+    const int saved_errno = errno;
+    ::close(fd);
+    errno = saved_errno;
+    return success;
+}
+
+bool SourceBuffer::assign(const char *const p_data, const size_t p_size) {
+    release();
+
+    char *const data =
+        static_cast<char *>(std::malloc(p_size + kNumOfPaddingBytes));
+    if (data == nullptr) {
+        errno = ENOMEM;
+        return false;
+    }
+    std::memcpy(data, p_data, p_size);
+    std::memset(data + p_size, 0, kNumOfPaddingBytes);
+    m_data = data;
+    m_size = p_size;
+    return true;
+}
+
+bool SourceBuffer::map(const int p_fd, const size_t p_size) {
+    // Reserve zero-filled memory for the source and its padding first, then
+    // map the file over the front of it. The tail of the last file page and
+    // the reserved pages behind it read as zeros, which gives us the NUL
+    // bytes without touching the file.
+    const size_t length = roundUpToPageSize(p_size + kNumOfPaddingBytes);
+    void *const reserved = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        return false;
+    }
+
+    void *const mapped = mmap(reserved, p_size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_FIXED, p_fd, 0);
+    if (mapped == MAP_FAILED) {
+        munmap(reserved, length);
+        return false;
+    }
+    madvise(mapped, p_size, MADV_SEQUENTIAL);
+
+    m_data = static_cast<char *>(mapped);
+    m_size = p_size;
+    m_mapping_length = length;
+    return true;
+}
+
+bool SourceBuffer::read(const int p_fd) {
+    size_t capacity = 4096;
+    size_t size = 0;
+    char *data = static_cast<char *>(std::malloc(capacity));
+
+    for (;;) {
+        if (data == nullptr) {
+            errno = ENOMEM;
+            return false;
+        }
+        if (capacity - size < kNumOfPaddingBytes + 1) {
+            capacity *= 2;
+            char *const grown = static_cast<char *>(std::realloc(data, capacity));
+            if (grown == nullptr) {
+                std::free(data);
+            }
+            data = grown;
+            continue;
+        }
+
+        const ssize_t count =
+            ::read(p_fd, data + size, capacity - size - kNumOfPaddingBytes);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::free(data);
+            return false;
+        }
+        if (count == 0) {
+            break;
+        }
+        size += static_cast<size_t>(count);
+    }
+
+    std::memset(data + size, 0, kNumOfPaddingBytes);
+    m_data = data;
+    m_size = size;
+    return true;
+}
@@ -0,0 +1,46 @@
+#include "util/StringInterner.hpp"
+
+#include <cstring>
+
+StringInterner::StringInterner() {
+    intern(""); // kEmptyAtom
+}
+
+const char *StringInterner::store(const std::string_view p_spelling) {
+    const size_t size = p_spelling.size() + 1; // with the terminating NUL
+
+    char *storage;
+    if (size > kBlockSize / 4) {
+        // long spellings get a block of their own, so the current block is
+        // not wasted
+        m_blocks.emplace_back(new char[size]);
+        storage = m_blocks.back().get();
+    } else {
+        if (size > m_block_remaining) {
+            m_blocks.emplace_back(new char[kBlockSize]);
+            m_block_cursor = m_blocks.back().get();
+            m_block_remaining = kBlockSize;
+        }
+        storage = m_block_cursor;
+        m_block_cursor += size;
+        m_block_remaining -= size;
+    }
+
+    std::memcpy(storage, p_spelling.data(), p_spelling.size());
+    storage[p_spelling.size()] = '\0';
+    return storage;
+}
+
+Atom StringInterner::intern(const std::string_view p_spelling) {
+    const auto found = m_atoms.find(p_spelling);
+    if (found != m_atoms.end()) {
+        return found->second;
+    }
+
+    // key the map with the stored copy, the caller's view may not outlive us
+    const std::string_view stored(store(p_spelling), p_spelling.size());
+    const Atom atom = static_cast<Atom>(m_spellings.size());
+    m_spellings.push_back(stored);
+    m_atoms.emplace(stored, atom);
+    return atom;
+}
@@ -0,0 +1,43 @@
+#include "util/StringLiteralPool.hpp"
+
+#include <functional>
+
+void StringLiteralPool::grow() {
+    std::vector<StringLiteralId> slots(m_slots.size() * 2, kEmptySlot);
+    const size_t mask = slots.size() - 1;
+
+    for (StringLiteralId id = 0; id < m_literals.size(); ++id) {
+        size_t slot = m_literals[id].hash & mask;
+        while (slots[slot] != kEmptySlot) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+    m_slots.swap(slots);
+}
+
+StringLiteralId StringLiteralPool::add(const std::string_view p_literal) {
+    const size_t hash = std::hash<std::string_view>{}(p_literal);
+    const size_t mask = m_slots.size() - 1;
+
+    size_t slot = hash & mask;
+    for (; m_slots[slot] != kEmptySlot; slot = (slot + 1) & mask) {
+        const StringLiteralId id = m_slots[slot];
+        if (m_literals[id].hash == hash && getString(id) == p_literal) {
+            return id;
+        }
+    }
+
+    const StringLiteralId id = static_cast<StringLiteralId>(m_literals.size());
+    m_literals.push_back({static_cast<uint32_t>(m_data.size()),
+                          static_cast<uint32_t>(p_literal.size()), hash});
+    m_data.insert(m_data.end(), p_literal.begin(), p_literal.end());
+    m_data.push_back('\0');
+
+    m_slots[slot] = id;
+    // keep the load factor at most 1/2
+    if (m_literals.size() * 2 > m_slots.size()) {
+        grow();
+    }
+    return id;
+}
@@ -0,0 +1,3 @@
+#include "visitor/FlatAstVisitor.hpp"
+
+FlatAstVisitor::~FlatAstVisitor() {}
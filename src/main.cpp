@@ -0,0 +1,139 @@
+#include "driver/Compiler.hpp"
+#include "util/SourceBuffer.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+struct Options {
+    const char *source_path = nullptr;
+    bool use_mmap = true;
+    bool diff_lexers = false;
+    CompileOptions compile;
+};
+
+static void printUsage(const char *const p_program) {
+    fprintf(stderr,
+            "Usage: %s <filename> [--dump-ast[=text|json|bin]] [--no-mmap] "
+            "[--lexer=flex|fast|threaded|parallel|diff] "
+            "[--lexer-threads=N] [--parser=bison|descent] [--lex-only] "
+            "[--syntax-only] [--parse-only] [--lazy-bodies] [--stream] "
+            "[--flat-ast] [--traversals=N] [--ast-cache=DIR] "
+            "[--concurrent-passes=N] [--stats=ast]\n",
+            p_program);
+}
+
+static Options parseOptions(const int argc, const char *argv[]) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        exit(-1);
+    }
+
+    Options options;
+    options.source_path = argv[1];
+    options.compile.num_of_lexer_threads = std::thread::hardware_concurrency();
+    for (int i = 2; i < argc; ++i) {
+        if (strcmp(argv[i], "--dump-ast") == 0 ||
+            strcmp(argv[i], "--dump-ast=text") == 0) {
+            options.compile.dump_ast = true;
+            options.compile.ast_dump_format = AstDumpFormat::kText;
+        } else if (strcmp(argv[i], "--dump-ast=json") == 0) {
+            options.compile.dump_ast = true;
+            options.compile.ast_dump_format = AstDumpFormat::kJson;
+        } else if (strcmp(argv[i], "--dump-ast=bin") == 0) {
+            options.compile.dump_ast = true;
+            options.compile.ast_dump_format = AstDumpFormat::kBinary;
+        } else if (strcmp(argv[i], "--no-mmap") == 0) {
+            options.use_mmap = false;
+        } else if (strcmp(argv[i], "--lex-only") == 0) {
+            options.compile.lex_only = true;
+        } else if (strcmp(argv[i], "--syntax-only") == 0) {
+            options.compile.syntax_only = true;
+        } else if (strcmp(argv[i], "--parse-only") == 0) {
+            options.compile.parse_only = true;
+        } else if (strcmp(argv[i], "--lazy-bodies") == 0) {
+            options.compile.lazy_function_bodies = true;
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            options.compile.stream_functions = true;
+        } else if (strcmp(argv[i], "--stats=ast") == 0) {
+            options.compile.ast_stats = true;
+        } else if (strcmp(argv[i], "--flat-ast") == 0) {
+            options.compile.flat_ast = true;
+        } else if (strcmp(argv[i], "--lexer=flex") == 0) {
+            options.compile.lexer = LexerKind::kFlex;
+        } else if (strcmp(argv[i], "--lexer=fast") == 0) {
+            options.compile.lexer = LexerKind::kFast;
+        } else if (strcmp(argv[i], "--lexer=threaded") == 0) {
+            options.compile.lexer = LexerKind::kThreaded;
+        } else if (strcmp(argv[i], "--lexer=parallel") == 0) {
+            options.compile.lexer = LexerKind::kParallel;
+        } else if (strcmp(argv[i], "--parser=bison") == 0) {
+            options.compile.parser = ParserKind::kBison;
+        } else if (strcmp(argv[i], "--parser=descent") == 0) {
+            options.compile.parser = ParserKind::kDescent;
+        } else if (strcmp(argv[i], "--lexer=diff") == 0) {
+            options.diff_lexers = true;
+        } else if (strncmp(argv[i], "--lexer-threads=", 16) == 0) {
+            options.compile.num_of_lexer_threads =
+                strtoul(argv[i] + 16, NULL, 10);
+            if (options.compile.num_of_lexer_threads == 0) {
+                fprintf(stderr, "Invalid number of threads: %s\n", argv[i]);
+                exit(-1);
+            }
+        } else if (strncmp(argv[i], "--traversals=", 13) == 0) {
+            options.compile.num_of_traversals =
+                strtoul(argv[i] + 13, NULL, 10);
+            if (options.compile.num_of_traversals == 0) {
+                fprintf(stderr, "Invalid number of traversals: %s\n",
+                        argv[i]);
+                exit(-1);
+            }
+        } else if (strncmp(argv[i], "--ast-cache=", 12) == 0) {
+            options.compile.ast_cache_directory = argv[i] + 12;
+        } else if (strncmp(argv[i], "--concurrent-passes=", 20) == 0) {
+            options.compile.num_of_concurrent_passes =
+                strtoul(argv[i] + 20, NULL, 10);
+            if (options.compile.num_of_concurrent_passes == 0) {
+                fprintf(stderr, "Invalid number of threads: %s\n", argv[i]);
+                exit(-1);
+            }
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            printUsage(argv[0]);
+            exit(-1);
+        }
+    }
+    if (options.compile.stream_functions && options.compile.dump_ast) {
+        fprintf(stderr, "--stream cannot be combined with --dump-ast\n");
+        exit(-1);
+    }
+    if (const char *const error = getOptionsError(options.compile)) {
+        fprintf(stderr, "%s\n", error);
+        exit(-1);
+    }
+    if (options.compile.flat_ast && options.compile.dump_ast &&
+        options.compile.ast_dump_format != AstDumpFormat::kText) {
+        fprintf(stderr, "--flat-ast only dumps the AST as text\n");
+        exit(-1);
+    }
+    return options;
+}
+
+int main(int argc, const char *argv[]) {
+    Options options = parseOptions(argc, argv);
+
+    SourceBuffer source;
+    if (!source.open(options.source_path, options.use_mmap)) {
+        perror("open() failed");
+        exit(-1);
+    }
+    if (options.diff_lexers) {
+        return diffLexers(source, stdout) ? 0 : 1;
+    }
+
+    options.compile.output = stdout;
+    options.compile.diagnostics = stderr;
+    const CompileResult result = compile(source, options.compile);
+    return result.is_successful ? 0 : -1;
+}
@@ -22,45 +22,61 @@
 #include "AST/constant.hpp"
 #include "AST/operator.hpp"
 
-#include "AST/AstDumper.hpp"
+#include "driver/CompilationContext.hpp"
+#include "driver/Compiler.hpp"
+#include "lexer/FastLexer.hpp"
+#include "lexer/FlexScanner.hpp"
 #include "sema/SemanticAnalyzer.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <vector>
+%}
 
-#define YYLTYPE yyltype
-
-typedef struct YYLTYPE {
-    uint32_t first_line;
-    uint32_t first_column;
-    uint32_t last_line;
-    uint32_t last_column;
-} yyltype;
-
-extern int32_t line_num;    /* declared in scanner.l */
-extern char current_line[]; /* declared in scanner.l */
-extern FILE *yyin;          /* declared by lex */
-extern char *yytext;        /* declared by lex */
-
-extern bool dumpSymbolTable;   /* declared in scanner.l */
-extern char *source_code[200]; /* declared in scanner.l */
+%require "3.2"
+%language "c++"
+%skeleton "lalr1.cc"
 
-static AstNode *root;
+    /* all state is in the CompilationContext, see driver/Compiler.hpp */
+%locations
+%parse-param {CompilationContext &context}
+%lex-param {CompilationContext &context}
 
-extern "C" int yylex(void);
-static void yyerror(const char *msg);
-extern int yylex_destroy(void);
-%}
+    /* semantic values are C++ objects and move through the stack by value */
+%define api.value.type variant
+%define api.location.type {YYLTYPE}
 
 %code requires {
     #include "AST/utils.hpp"
     #include "AST/PType.hpp"
-
-    #include <vector>
-    #include <memory>
-
+    #include "lexer/Token.hpp"
+    #include "util/Arena.hpp"
+    #include "util/StringLiteralPool.hpp"
+
+    #include <cstdint>
+
+    // as the C skeletons do it, lalr1.cc assumes yy::location
+    #define YYLLOC_DEFAULT(Current, Rhs, N)                               \
+        do {                                                              \
+            if (N) {                                                      \
+                (Current).first_line = YYRHSLOC(Rhs, 1).first_line;       \
+                (Current).first_column = YYRHSLOC(Rhs, 1).first_column;   \
+                (Current).last_line = YYRHSLOC(Rhs, N).last_line;         \
+                (Current).last_column = YYRHSLOC(Rhs, N).last_column;     \
+            } else {                                                      \
+                (Current).first_line = (Current).last_line =              \
+                    YYRHSLOC(Rhs, 0).last_line;                           \
+                (Current).first_column = (Current).last_column =          \
+                    YYRHSLOC(Rhs, 0).last_column;                         \
+            }                                                             \
+        } while (0)
+
+    struct CompilationContext;
+    struct LazyFunctionBody;
     class AstNode;
     class DeclNode;
     class ConstantValueNode;
@@ -69,54 +85,33 @@ extern int yylex_destroy(void);
     class ExpressionNode;
 }
 
-    /* For yylval */
-%union {
-    /* basic semantic value */
-    char *identifier;
-    uint32_t integer;
-    double real;
-    char *string;
-    bool boolean;
-
-    int32_t sign;
-
-    AstNode *node;
-    PType *type_ptr;
-    DeclNode *decl_ptr;
-    CompoundStatementNode *compound_stmt_ptr;
-    ConstantValueNode *constant_value_node_ptr;
-    FunctionNode *func_ptr;
-    ExpressionNode *expr_ptr;
-
-    std::vector<std::unique_ptr<DeclNode>> *decls_ptr;
-    std::vector<IdInfo> *ids_ptr;
-    std::vector<uint64_t> *dimensions_ptr;
-    std::vector<std::unique_ptr<FunctionNode>> *funcs_ptr;
-    std::vector<std::unique_ptr<AstNode>> *nodes_ptr;
-    std::vector<std::unique_ptr<ExpressionNode>> *exprs_ptr;
-};
-
-%type <identifier> ProgramName ID FunctionName
-%type <integer> INT_LITERAL
-%type <real> REAL_LITERAL
-%type <string> STRING_LITERAL
-%type <boolean> TRUE FALSE
-%type <sign> NegOrNot
-
-%type <node> Statement Simple Condition While For Return FunctionCall
-%type <type_ptr> Type ScalarType ArrType ReturnType
-%type <decl_ptr> Declaration FormalArg
-%type <compound_stmt_ptr> CompoundStatement ElseOrNot
-%type <constant_value_node_ptr> LiteralConstant StringAndBoolean
-%type <func_ptr> Function FunctionDeclaration FunctionDefinition
-%type <expr_ptr> Expression IntegerAndReal FunctionInvocation VariableReference
-
-%type <decls_ptr> DeclarationList Declarations FormalArgList FormalArgs
-%type <ids_ptr> IdList
-%type <dimensions_ptr> ArrDecl
-%type <funcs_ptr> FunctionList Functions
-%type <nodes_ptr> StatementList Statements
-%type <exprs_ptr> ExpressionList Expressions ArrRefList ArrRefs
+%code {
+    int yylex(yy::parser::semantic_type *yylval, YYLTYPE *yylloc,
+              CompilationContext &context);
+    /* declared in scanner.l */
+    int scanToken(TokenValue *yylval_param, YYLTYPE *yylloc_param,
+                  FlexScanner yyscanner);
+}
+
+    /* Atom, StringLiteralId and TypeId are uint32_t too; bison wants one
+       spelling of a type */
+%type <uint32_t> ProgramName FunctionName
+%type <uint32_t> Type ScalarType ArrType ReturnType
+%type <int32_t> NegOrNot
+
+%type <AstNode *> Statement Simple Condition While For Return FunctionCall
+%type <DeclNode *> Declaration FormalArg
+%type <CompoundStatementNode *> CompoundStatement ElseOrNot
+%type <ConstantValueNode *> LiteralConstant StringAndBoolean
+%type <FunctionNode *> Function FunctionDeclaration FunctionDefinition
+%type <ExpressionNode *> Expression IntegerAndReal FunctionInvocation VariableReference
+
+%type <ArenaVector<DeclNode *>> DeclarationList Declarations FormalArgList FormalArgs
+%type <ArenaVector<IdInfo>> IdList
+%type <ArenaVector<uint64_t>> ArrDecl
+%type <ArenaVector<FunctionNode *>> FunctionList Functions
+%type <ArenaVector<AstNode *>> StatementList Statements
+%type <ArenaVector<ExpressionNode *>> ExpressionList Expressions ArrRefList ArrRefs
 
     /* Follow the order in scanner.l */
 
@@ -140,32 +135,53 @@ extern int yylex_destroy(void);
 %token END BEGIN_ /* Use BEGIN_ since BEGIN is a keyword in lex */
 %token DO ELSE FOR IF THEN WHILE
 %token DEF OF TO RETURN VAR
-%token FALSE TRUE
+%token <bool> FALSE TRUE
 %token PRINT READ
 
     /* Identifier */
-%token ID
+%token <uint32_t> ID
 
     /* Literal */
-%token INT_LITERAL
-%token REAL_LITERAL
-%token STRING_LITERAL
+%token <uint32_t> INT_LITERAL
+%token <double> REAL_LITERAL
+%token <uint32_t> STRING_LITERAL
+
+    /* Never reaches the grammar, see yylex() */
+%token BAD_CHARACTER
+
+    /* Do not come from a lexer, see yylex() */
+%token <LazyFunctionBody *> LAZY_BODY /* a function body that was skipped */
+%token BODY_ONLY /* the input is a single function body */
 
 %%
 
+Start:
+    Program
+    |
+    BODY_ONLY CompoundStatement {
+        context.root = $2;
+    }
+;
+
 Program:
     ProgramName SEMICOLON
     /* ProgramBody */
-    DeclarationList FunctionList CompoundStatement
+    DeclarationList {
+        if (context.analyzer != nullptr) {
+            context.analyzer->beginProgram(
+                $1, Location(@1.first_line, @1.first_column));
+            for (DeclNode *const decl : $3) {
+                context.analyzer->walk(*decl);
+            }
+            context.functions_mark = Arena::getInstance().getMark();
+        }
+    }
+    FunctionList CompoundStatement
     /* End of ProgramBody */
     END {
-        root = new ProgramNode(@1.first_line, @1.first_column,
-                               $1, new PType(PType::PrimitiveTypeEnum::kVoidType),
-                               *$3, *$4, $5);
-
-        free($1);
-        delete $3;
-        delete $4;
+        context.root = newInArena<ProgramNode>(@1.first_line, @1.first_column,
+                                               $1, TypeContext::kVoidType, $3,
+                                               $5, $6);
     }
 ;
 
@@ -175,7 +191,7 @@ ProgramName:
 
 DeclarationList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<DeclNode>>();
+        $$ = ArenaVector<DeclNode *>();
     }
     |
     Declarations
@@ -183,19 +199,18 @@ DeclarationList:
 
 Declarations:
     Declaration {
-        $$ = new std::vector<std::unique_ptr<DeclNode>>();
-        $$->emplace_back($1);
+        $$.emplace_back($1);
     }
     |
     Declarations Declaration {
-        $1->emplace_back($2);
-        $$ = $1;
+        $$ = std::move($1);
+        $$.emplace_back($2);
     }
 ;
 
 FunctionList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<FunctionNode>>();
+        $$ = ArenaVector<FunctionNode *>();
     }
     |
     Functions
@@ -203,13 +218,22 @@ FunctionList:
 
 Functions:
     Function {
-        $$ = new std::vector<std::unique_ptr<FunctionNode>>();
-        $$->emplace_back($1);
+        if (context.analyzer != nullptr) {
+            context.analyzer->walk(*$1);
+            Arena::getInstance().rewind(context.functions_mark);
+        } else {
+            $$.emplace_back($1);
+        }
     }
     |
     Functions Function {
-        $1->emplace_back($2);
-        $$ = $1;
+        $$ = std::move($1);
+        if (context.analyzer != nullptr) {
+            context.analyzer->walk(*$2);
+            Arena::getInstance().rewind(context.functions_mark);
+        } else {
+            $$.emplace_back($2);
+        }
     }
 ;
 
@@ -221,9 +245,8 @@ Function:
 
 FunctionDeclaration:
     FunctionName L_PARENTHESIS FormalArgList R_PARENTHESIS ReturnType SEMICOLON {
-        $$ = new FunctionNode(@1.first_line, @1.first_column, $1, *$3, $5, nullptr);
-        free($1);
-        delete $3;
+        $$ = newInArena<FunctionNode>(@1.first_line, @1.first_column, $1, $3,
+                                      $5, nullptr);
     }
 ;
 
@@ -231,9 +254,15 @@ FunctionDefinition:
     FunctionName L_PARENTHESIS FormalArgList R_PARENTHESIS ReturnType
     CompoundStatement
     END {
-        $$ = new FunctionNode(@1.first_line, @1.first_column, $1, *$3, $5, $6);
-        free($1);
-        delete $3;
+        $$ = newInArena<FunctionNode>(@1.first_line, @1.first_column, $1, $3,
+                                      $5, $6);
+    }
+    |
+    FunctionName L_PARENTHESIS FormalArgList R_PARENTHESIS ReturnType
+    LAZY_BODY
+    END {
+        $$ = newInArena<FunctionNode>(@1.first_line, @1.first_column, $1, $3,
+                                      $5, nullptr, $6);
     }
 ;
 
@@ -243,7 +272,7 @@ FunctionName:
 
 FormalArgList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<DeclNode>>();
+        $$ = ArenaVector<DeclNode *>();
     }
     |
     FormalArgs
@@ -251,34 +280,29 @@ FormalArgList:
 
 FormalArgs:
     FormalArg {
-        $$ = new std::vector<std::unique_ptr<DeclNode>>();
-        $$->emplace_back($1);
+        $$.emplace_back($1);
     }
     |
     FormalArgs SEMICOLON FormalArg {
-        $1->emplace_back($3);
-        $$ = $1;
+        $$ = std::move($1);
+        $$.emplace_back($3);
     }
 ;
 
 FormalArg:
     IdList COLON Type {
-        $$ = new DeclNode(@1.first_line, @1.first_column, $1, $3);
-        delete $1;
+        $$ = newInArena<DeclNode>(@1.first_line, @1.first_column, $1, $3);
     }
 ;
 
 IdList:
     ID {
-        $$ = new std::vector<IdInfo>();
-        $$->emplace_back(@1.first_line, @1.first_column, $1);
-        free($1);
+        $$.emplace_back(@1.first_line, @1.first_column, $1);
     }
     |
     IdList COMMA ID {
-        $1->emplace_back(@3.first_line, @3.first_column, $3);
-        free($3);
-        $$ = $1;
+        $$ = std::move($1);
+        $$.emplace_back(@3.first_line, @3.first_column, $3);
     }
 ;
 
@@ -288,7 +312,7 @@ ReturnType:
     }
     |
     Epsilon {
-        $$ = new PType(PType::PrimitiveTypeEnum::kVoidType);
+        $$ = TypeContext::kVoidType;
     }
 ;
 
@@ -298,13 +322,11 @@ ReturnType:
 
 Declaration:
     VAR IdList COLON Type SEMICOLON {
-        $$ = new DeclNode(@1.first_line, @1.first_column, $2, $4);
-        delete $2;
+        $$ = newInArena<DeclNode>(@1.first_line, @1.first_column, $2, $4);
     }
     |
     VAR IdList COLON LiteralConstant SEMICOLON {
-        $$ = new DeclNode(@1.first_line, @1.first_column, $2, $4);
-        delete $2;
+        $$ = newInArena<DeclNode>(@1.first_line, @1.first_column, $2, $4);
     }
 ;
 
@@ -314,33 +336,31 @@ Type:
     ArrType
 ;
 
-    /* no need to release PType object since it'll be assigned to the shared_ptr */
 ScalarType:
-    INTEGER { $$ = new PType(PType::PrimitiveTypeEnum::kIntegerType); }
+    INTEGER { $$ = TypeContext::kIntegerType; }
     |
-    REAL { $$ = new PType(PType::PrimitiveTypeEnum::kRealType); }
+    REAL { $$ = TypeContext::kRealType; }
     |
-    STRING { $$ = new PType(PType::PrimitiveTypeEnum::kStringType); }
+    STRING { $$ = TypeContext::kStringType; }
     |
-    BOOLEAN { $$ = new PType(PType::PrimitiveTypeEnum::kBoolType); }
+    BOOLEAN { $$ = TypeContext::kBoolType; }
 ;
 
 ArrType:
     ArrDecl ScalarType {
-        $2->setDimensions(*$1);
-        delete $1;
-        $$ = $2;
+        $$ = TypeContext::getInstance().intern(
+            getPType($2).getPrimitiveType(), $1.begin(), $1.size());
     }
 ;
 
 ArrDecl:
     ARRAY INT_LITERAL OF {
-        $$ = new std::vector<uint64_t>{static_cast<uint64_t>($2)};
+        $$.emplace_back(static_cast<uint64_t>($2));
     }
     |
     ArrDecl ARRAY INT_LITERAL OF {
-        $1->emplace_back(static_cast<uint64_t>($3));
-        $$ = $1;
+        $$ = std::move($1);
+        $$.emplace_back(static_cast<uint64_t>($3));
     }
 ;
 
@@ -348,25 +368,21 @@ LiteralConstant:
     NegOrNot INT_LITERAL {
         Constant::ConstantValue value;
         value.integer = static_cast<int64_t>($1) * static_cast<int64_t>($2);
-        auto * const constant = new Constant(
-            std::make_shared<PType>(
-				PType::PrimitiveTypeEnum::kIntegerType),
-            value);
+        auto * const constant =
+            newInArena<Constant>(TypeContext::kIntegerType, value);
         auto * const pos = ($1 == 1) ? &@2 : &@1;
-        // no need to release constant object since it'll be assigned to the unique_ptr
-        $$ = new ConstantValueNode(pos->first_line, pos->first_column, constant);
+        $$ = newInArena<ConstantValueNode>(pos->first_line, pos->first_column,
+                                           constant);
     }
     |
     NegOrNot REAL_LITERAL {
         Constant::ConstantValue value;
         value.real = static_cast<double>($1) * static_cast<double>($2);
-        auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kRealType),
-            value);
+        auto * const constant =
+            newInArena<Constant>(TypeContext::kRealType, value);
         auto * const pos = ($1 == 1) ? &@2 : &@1;
-        // no need to release constant object since it'll be assigned to the unique_ptr
-        $$ = new ConstantValueNode(pos->first_line, pos->first_column, constant);
+        $$ = newInArena<ConstantValueNode>(pos->first_line, pos->first_column,
+                                           constant);
     }
     |
     StringAndBoolean
@@ -386,31 +402,28 @@ StringAndBoolean:
     STRING_LITERAL {
         Constant::ConstantValue value;
         value.string = $1;
-        auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kStringType),
-            value);
-        $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
+        auto * const constant =
+            newInArena<Constant>(TypeContext::kStringType, value);
+        $$ = newInArena<ConstantValueNode>(@1.first_line, @1.first_column,
+                                           constant);
     }
     |
     TRUE {
         Constant::ConstantValue value;
         value.boolean = $1;
-        auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kBoolType),
-            value);
-        $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
+        auto * const constant =
+            newInArena<Constant>(TypeContext::kBoolType, value);
+        $$ = newInArena<ConstantValueNode>(@1.first_line, @1.first_column,
+                                           constant);
     }
     |
     FALSE {
         Constant::ConstantValue value;
         value.boolean = $1;
-        auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kBoolType),
-            value);
-        $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
+        auto * const constant =
+            newInArena<Constant>(TypeContext::kBoolType, value);
+        $$ = newInArena<ConstantValueNode>(@1.first_line, @1.first_column,
+                                           constant);
     }
 ;
 
@@ -418,23 +431,19 @@ IntegerAndReal:
     INT_LITERAL {
         Constant::ConstantValue value;
         value.integer = static_cast<int64_t>($1);
-        auto * const constant = new Constant(
-            std::make_shared<PType>(
-				PType::PrimitiveTypeEnum::kIntegerType),
-            value);
-        // no need to release constant object since it'll be assigned to the unique_ptr
-        $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
+        auto * const constant =
+            newInArena<Constant>(TypeContext::kIntegerType, value);
+        $$ = newInArena<ConstantValueNode>(@1.first_line, @1.first_column,
+                                           constant);
     }
     |
     REAL_LITERAL {
         Constant::ConstantValue value;
         value.real = static_cast<double>($1);
-        auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kRealType),
-            value);
-        // no need to release constant object since it'll be assigned to the unique_ptr
-        $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
+        auto * const constant =
+            newInArena<Constant>(TypeContext::kRealType, value);
+        $$ = newInArena<ConstantValueNode>(@1.first_line, @1.first_column,
+                                           constant);
     }
 ;
 
@@ -465,40 +474,38 @@ CompoundStatement:
     DeclarationList
     StatementList
     END {
-        $$ = new CompoundStatementNode(@1.first_line, @1.first_column,
-                                       *$2, *$3);
-        delete $2;
-        delete $3;
+        $$ = newInArena<CompoundStatementNode>(@1.first_line, @1.first_column,
+                                               $2, $3);
     }
 ;
 
 Simple:
     VariableReference ASSIGN Expression SEMICOLON {
-        $$ = new AssignmentNode(@2.first_line, @2.first_column,
-                                dynamic_cast<VariableReferenceNode *>($1), $3);
+        $$ = newInArena<AssignmentNode>(
+            @2.first_line, @2.first_column,
+            dynamic_cast<VariableReferenceNode *>($1), $3);
     }
     |
     PRINT Expression SEMICOLON {
-        $$ = new PrintNode(@1.first_line, @1.first_column, $2);
+        $$ = newInArena<PrintNode>(@1.first_line, @1.first_column, $2);
     }
     |
     READ VariableReference SEMICOLON {
-        $$ = new ReadNode(@1.first_line, @1.first_column,
-                          dynamic_cast<VariableReferenceNode *>($2));
+        $$ = newInArena<ReadNode>(@1.first_line, @1.first_column,
+                                  dynamic_cast<VariableReferenceNode *>($2));
     }
 ;
 
 VariableReference:
     ID ArrRefList {
-        $$ = new VariableReferenceNode(@1.first_line, @1.first_column, $1, *$2);
-        free($1);
-        delete $2;
+        $$ = newInArena<VariableReferenceNode>(@1.first_line, @1.first_column,
+                                               $1, $2);
     }
 ;
 
 ArrRefList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<ExpressionNode>>();
+        $$ = ArenaVector<ExpressionNode *>();
     }
     |
     ArrRefs
@@ -506,13 +513,12 @@ ArrRefList:
 
 ArrRefs:
     L_BRACKET Expression R_BRACKET {
-        $$ = new std::vector<std::unique_ptr<ExpressionNode>>();
-        $$->emplace_back($2);
+        $$.emplace_back($2);
     }
     |
     ArrRefs L_BRACKET Expression R_BRACKET {
-        $1->emplace_back($3);
-        $$ = $1;
+        $$ = std::move($1);
+        $$.emplace_back($3);
     }
 ;
 
@@ -521,7 +527,7 @@ Condition:
     CompoundStatement
     ElseOrNot
     END IF {
-        $$ = new IfNode(@1.first_line, @1.first_column, $2, $4, $5);
+        $$ = newInArena<IfNode>(@1.first_line, @1.first_column, $2, $4, $5);
     }
 ;
 
@@ -540,7 +546,7 @@ While:
     WHILE Expression DO
     CompoundStatement
     END DO {
-        $$ = new WhileNode(@1.first_line, @1.first_column, $2, $4);
+        $$ = newInArena<WhileNode>(@1.first_line, @1.first_column, $2, $4);
     }
 ;
 
@@ -553,41 +559,36 @@ For:
         ConstantValueNode *constant_value_node;
 
         // DeclNode
-        auto *ids = new std::vector<IdInfo>{IdInfo(@2.first_line, @2.first_column,
-                                                   $2)};
-        auto *type = new PType(PType::PrimitiveTypeEnum::kIntegerType);
-        auto *var_decl = new DeclNode(@2.first_line, @2.first_column, ids, type);
+        ArenaVector<IdInfo> ids;
+        ids.emplace_back(@2.first_line, @2.first_column, $2);
+        auto *var_decl = newInArena<DeclNode>(@2.first_line, @2.first_column,
+                                              ids, TypeContext::kIntegerType);
 
         // AssignmentNode
-        auto *var_ref = new VariableReferenceNode(@2.first_line, @2.first_column, $2);
+        auto *var_ref = newInArena<VariableReferenceNode>(
+            @2.first_line, @2.first_column, $2);
         value.integer = static_cast<int64_t>($4);
-        constant = new Constant(
-            std::make_shared<PType>(PType::PrimitiveTypeEnum::kIntegerType),
-            value);
-        constant_value_node = new ConstantValueNode(@4.first_line, @4.first_column,
-                                                    constant);
-        auto *assignment = new AssignmentNode(@3.first_line, @3.first_column,
-                                              var_ref, constant_value_node);
+        constant = newInArena<Constant>(TypeContext::kIntegerType, value);
+        constant_value_node = newInArena<ConstantValueNode>(
+            @4.first_line, @4.first_column, constant);
+        auto *assignment = newInArena<AssignmentNode>(
+            @3.first_line, @3.first_column, var_ref, constant_value_node);
 
         // ExpressionNode
         value.integer = static_cast<int64_t>($6);
-        constant = new Constant(
-            std::make_shared<PType>(PType::PrimitiveTypeEnum::kIntegerType),
-            value);
-        constant_value_node = new ConstantValueNode(@6.first_line, @6.first_column,
-                                                    constant);
+        constant = newInArena<Constant>(TypeContext::kIntegerType, value);
+        constant_value_node = newInArena<ConstantValueNode>(
+            @6.first_line, @6.first_column, constant);
 
-        $$ = new ForNode(@1.first_line, @1.first_column,
-                         var_decl, assignment, constant_value_node,
-                         $8);
-        free($2);
-        delete ids;
+        $$ = newInArena<ForNode>(@1.first_line, @1.first_column,
+                                 var_decl, assignment, constant_value_node,
+                                 $8);
     }
 ;
 
 Return:
     RETURN Expression SEMICOLON {
-        $$ = new ReturnNode(@1.first_line, @1.first_column, $2);
+        $$ = newInArena<ReturnNode>(@1.first_line, @1.first_column, $2);
     }
 ;
 
@@ -599,15 +600,14 @@ FunctionCall:
 
 FunctionInvocation:
     ID L_PARENTHESIS ExpressionList R_PARENTHESIS {
-        $$ = new FunctionInvocationNode(@1.first_line, @1.first_column, $1, *$3);
-        free($1);
-        delete $3;
+        $$ = newInArena<FunctionInvocationNode>(@1.first_line, @1.first_column,
+                                                $1, $3);
     }
 ;
 
 ExpressionList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<ExpressionNode>>();
+        $$ = ArenaVector<ExpressionNode *>();
     }
     |
     Expressions
@@ -615,19 +615,18 @@ ExpressionList:
 
 Expressions:
     Expression {
-        $$ = new std::vector<std::unique_ptr<ExpressionNode>>();
-        $$->emplace_back($1);
+        $$.emplace_back($1);
     }
     |
     Expressions COMMA Expression {
-        $1->emplace_back($3);
-        $$ = $1;
+        $$ = std::move($1);
+        $$.emplace_back($3);
     }
 ;
 
 StatementList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<AstNode>>();
+        $$ = ArenaVector<AstNode *>();
     }
     |
     Statements
@@ -635,13 +634,12 @@ StatementList:
 
 Statements:
     Statement {
-        $$ = new std::vector<std::unique_ptr<AstNode>>();
-        $$->emplace_back($1);
+        $$.emplace_back($1);
     }
     |
     Statements Statement {
-        $1->emplace_back($2);
-        $$ = $1;
+        $$ = std::move($1);
+        $$.emplace_back($2);
     }
 ;
 
@@ -651,78 +649,79 @@ Expression:
     }
     |
     MINUS Expression %prec UNARY_MINUS {
-        $$ = new UnaryOperatorNode(@1.first_line, @1.first_column,
-                                   Operator::kNegOp, $2);
+        $$ = newInArena<UnaryOperatorNode>(@1.first_line, @1.first_column,
+                                           Operator::kNegOp, $2);
     }
     |
     Expression MULTIPLY Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kMultiplyOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kMultiplyOp, $1, $3);
     }
     |
     Expression DIVIDE Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kDivideOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kDivideOp, $1, $3);
     }
     |
     Expression MOD Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kModOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kModOp, $1, $3);
     }
     |
     Expression PLUS Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kPlusOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kPlusOp, $1, $3);
     }
     |
     Expression MINUS Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kMinusOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kMinusOp, $1, $3);
     }
     |
     Expression LESS Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kLessOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kLessOp, $1, $3);
     }
     |
     Expression LESS_OR_EQUAL Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kLessOrEqualOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kLessOrEqualOp, $1, $3);
     }
     |
     Expression GREATER Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kGreaterOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kGreaterOp, $1, $3);
     }
     |
     Expression GREATER_OR_EQUAL Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kGreaterOrEqualOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kGreaterOrEqualOp,
+                                            $1, $3);
     }
     |
     Expression EQUAL Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kEqualOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kEqualOp, $1, $3);
     }
     |
     Expression NOT_EQUAL Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kNotEqualOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kNotEqualOp, $1, $3);
     }
     |
     NOT Expression {
-        $$ = new UnaryOperatorNode(@1.first_line, @1.first_column,
-                                   Operator::kNotOp, $2);
+        $$ = newInArena<UnaryOperatorNode>(@1.first_line, @1.first_column,
+                                           Operator::kNotOp, $2);
     }
     |
     Expression AND Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kAndOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kAndOp, $1, $3);
     }
     |
     Expression OR Expression {
-        $$ = new BinaryOperatorNode(@2.first_line, @2.first_column,
-                                    Operator::kOrOp, $1, $3);
+        $$ = newInArena<BinaryOperatorNode>(@2.first_line, @2.first_column,
+                                            Operator::kOrOp, $1, $3);
     }
     |
     IntegerAndReal
@@ -744,47 +743,436 @@ Epsilon:
 
 %%
 
-void yyerror(const char *msg) {
-    fprintf(stderr,
+using token = yy::parser::token;
+
+// the parser's token for each TokenKind
+static const int kParserTokens[kNumOfTokenKinds] = {
+    token::YYEOF,
+    token::COMMA, token::SEMICOLON, token::COLON, token::L_PARENTHESIS,
+    token::R_PARENTHESIS, token::L_BRACKET, token::R_BRACKET,
+    token::PLUS, token::MINUS, token::MULTIPLY, token::DIVIDE, token::MOD,
+    token::ASSIGN, token::LESS, token::LESS_OR_EQUAL, token::NOT_EQUAL,
+    token::GREATER_OR_EQUAL, token::GREATER, token::EQUAL, token::AND,
+    token::OR, token::NOT,
+    token::VAR, token::ARRAY, token::OF, token::BOOLEAN, token::INTEGER,
+    token::REAL, token::STRING, token::TRUE, token::FALSE, token::DEF,
+    token::RETURN, token::BEGIN_, token::END, token::WHILE, token::DO,
+    token::IF, token::THEN, token::ELSE, token::FOR, token::TO, token::PRINT,
+    token::READ,
+    token::ID,
+    token::INT_LITERAL, token::REAL_LITERAL, token::STRING_LITERAL,
+    token::BAD_CHARACTER};
+
+// for the keywords that scanner.l looks up with lookUpKeyword()
+int getParserToken(const TokenKind kind) {
+    return kParserTokens[static_cast<size_t>(kind)];
+}
+
+// hands a token of FastLexer, ThreadedLexer or ParallelLexer, and the listing
+// before it, over to the parser
+static int passToken(CompilationContext &context, const Token &token,
+                     const std::string_view listing, const char *const source,
+                     TokenValue &value, YYLTYPE &location) {
+    if (context.output != nullptr) {
+        fwrite(listing.data(), 1, listing.size(), context.output);
+    }
+
+    context.last_token.line = token.line;
+    context.last_token.line_start = source + token.offset - (token.col - 1);
+    context.last_token.text = source + token.offset;
+    context.last_token.length = static_cast<int>(token.length);
+
+    if (token.kind != TokenKind::kEndOfInput) {
+        location.first_line = token.line;
+        location.first_column = token.col;
+    }
+    value = token.value;
+    return kParserTokens[static_cast<size_t>(token.kind)];
+}
+
+// The next token of whichever lexer the context has; the value is set for
+// the tokens that have one.
+static int nextToken(CompilationContext &context, TokenValue &value,
+                     YYLTYPE &location) {
+    int parser_token;
+    Token token;
+    if (context.threaded_lexer) {
+        ThreadedLexer &lexer = *context.threaded_lexer;
+        lexer.next(token);
+        parser_token = passToken(context, token, lexer.getListing(),
+                                 lexer.getSource(), value, location);
+    } else if (context.parallel_lexer) {
+        ParallelLexer &lexer = *context.parallel_lexer;
+        lexer.next(token);
+        parser_token = passToken(context, token, lexer.getListing(),
+                                 lexer.getSource(), value, location);
+    } else if (context.fast_lexer) {
+        FastLexer &lexer = *context.fast_lexer;
+        lexer.next(token);
+        std::string &listing = lexer.getListing();
+        parser_token = passToken(context, token, listing, lexer.getSource(),
+                                 value, location);
+        listing.clear();
+    } else {
+        parser_token = scanToken(&value, &location, context.flex_scanner);
+        context.last_token.line = context.flex_state.line_num;
+        context.last_token.line_start = context.flex_state.current_line_start;
+        context.last_token.text = getFlexScannerText(context.flex_scanner);
+        context.last_token.length = getFlexScannerLength(context.flex_scanner);
+    }
+
+    if (parser_token == token::BAD_CHARACTER) {
+        // the listing carries this one, as it always has
+        if (context.output != nullptr) {
+            fprintf(context.output,
+                    "Error at line %d: bad character \"%.*s\"\n",
+                    context.last_token.line, context.last_token.length,
+                    context.last_token.text);
+        }
+        // the input ends here; whatever the parser makes of that, it fails
+        context.has_error = true;
+        return token::YYEOF;
+    }
+    return parser_token;
+}
+
+// Reads the tokens of a function body up to the `end` that matches its
+// `begin`, which has been read. The statements that end in `end if` and
+// `end do` are kept track of, so that these do not count as the end of a
+// `begin`. nullptr if the input ends first.
+static LazyFunctionBody *skipFunctionBody(CompilationContext &context) {
+    const char *const source = context.source.getData();
+    auto *const body = newInArena<LazyFunctionBody>();
+    body->source = context.lazy_bodies;
+    body->begin = static_cast<uint32_t>(context.last_token.text - source);
+    body->line = context.last_token.line;
+    body->line_start =
+        static_cast<uint32_t>(context.last_token.line_start - source);
+
+    std::vector<int> &openers = context.body_openers;
+    openers.assign(1, token::BEGIN_);
+    int expected_token = 0; // the IF or DO after an `end`
+    TokenValue value;
+    YYLTYPE location;
+    while (!openers.empty()) {
+        const int parser_token = nextToken(context, value, location);
+        if (parser_token == token::YYEOF) {
+            return nullptr;
+        }
+        if (parser_token == expected_token) {
+            expected_token = 0;
+            continue;
+        }
+        expected_token = 0;
+
+        switch (parser_token) {
+        case token::BEGIN_:
+        case token::IF:
+        case token::WHILE:
+        case token::FOR:
+            openers.push_back(parser_token);
+            break;
+        case token::END:
+            if (openers.back() == token::IF) {
+                expected_token = token::IF;
+            } else if (openers.back() != token::BEGIN_) {
+                expected_token = token::DO;
+            }
+            openers.pop_back();
+            break;
+        default:
+            break;
+        }
+    }
+    body->end = static_cast<uint32_t>(context.last_token.text +
+                                      context.last_token.length - source);
+    return body;
+}
+
+int nextParserToken(CompilationContext &context, TokenValue &value,
+                    YYLTYPE &location, LazyFunctionBody *&body) {
+    if (context.first_token != 0) {
+        const int parser_token = context.first_token;
+        context.first_token = 0;
+        return parser_token;
+    }
+
+    int parser_token = nextToken(context, value, location);
+    // Only the body of a function definition follows the parameters or the
+    // return type directly.
+    if (parser_token == token::BEGIN_ && context.lazy_bodies != nullptr &&
+        (context.previous_token == token::R_PARENTHESIS ||
+         context.previous_token == token::INTEGER ||
+         context.previous_token == token::REAL ||
+         context.previous_token == token::STRING ||
+         context.previous_token == token::BOOLEAN)) {
+        body = skipFunctionBody(context);
+        // at the end of input, the parser must not ask the lexer for more
+        parser_token = (body != nullptr) ? token::LAZY_BODY : token::YYEOF;
+    }
+    context.previous_token = parser_token;
+    return parser_token;
+}
+
+int yylex(yy::parser::semantic_type *yylval, YYLTYPE *yylloc,
+          CompilationContext &context) {
+    TokenValue value;
+    LazyFunctionBody *body;
+    const int parser_token = nextParserToken(context, value, *yylloc, body);
+    switch (parser_token) {
+    case token::ID:
+        yylval->emplace<uint32_t>(value.identifier);
+        break;
+    case token::INT_LITERAL:
+        yylval->emplace<uint32_t>(value.integer);
+        break;
+    case token::REAL_LITERAL:
+        yylval->emplace<double>(value.real);
+        break;
+    case token::STRING_LITERAL:
+        yylval->emplace<uint32_t>(value.string);
+        break;
+    case token::TRUE:
+    case token::FALSE:
+        yylval->emplace<bool>(value.boolean);
+        break;
+    case token::LAZY_BODY:
+        yylval->emplace<LazyFunctionBody *>(body);
+        break;
+    default:
+        break;
+    }
+    return parser_token;
+}
+
+void reportSyntaxError(CompilationContext &context, const char *const reason) {
+    if (context.has_error) {
+        // the bad character that cut the input short is reported already
+        return;
+    }
+    context.has_error = true;
+    if (context.diagnostics == nullptr) {
+        return;
+    }
+
+    const auto &last_token = context.last_token;
+    fprintf(context.diagnostics,
             "\n"
             "|-----------------------------------------------------------------"
             "---------\n"
-            "| Error found in Line #%d: %s\n"
-            "|\n"
-            "| Unmatched token: %s\n"
+            "| Error found in Line #%d: %.*s\n"
+            "|\n",
+            last_token.line,
+            static_cast<int>(last_token.text + last_token.length -
+                             last_token.line_start),
+            last_token.line_start);
+    if (reason != nullptr) {
+        fprintf(context.diagnostics, "| %s\n", reason);
+    } else {
+        fprintf(context.diagnostics, "| Unmatched token: %.*s\n",
+                last_token.length, last_token.text);
+    }
+    fprintf(context.diagnostics,
             "|-----------------------------------------------------------------"
-            "---------\n",
-            line_num, current_line, yytext);
-    exit(-1);
+            "---------\n");
 }
 
-int main(int argc, const char *argv[]) {
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <filename> [--dump-ast]\n", argv[0]);
-        exit(-1);
-    }
+void yy::parser::error(const location_type &, const std::string &) {
+    reportSyntaxError(context);
+}
 
-    yyin = fopen(argv[1], "r");
-    if (yyin == NULL) {
-        perror("fopen() failed");
-        exit(-1);
-    }
+bool parseProgram(CompilationContext &context) {
+    yy::parser parser(context);
+    // a bad character makes yylex() end the input, which the grammar may
+    // accept
+    return parser.parse() == 0 && !context.has_error;
+}
+
+CompoundStatementNode *parseFunctionBody(const LazyFunctionBody &body) {
+    LazyFunctionBody::Source &source = *body.source;
+    // the body has been listed with the rest of the program
+    CompilationContext context(*source.buffer, nullptr, source.diagnostics);
+    context.fast_lexer.reset(new FastLexer(source.buffer->getData(),
+                                           body.begin, body.end, body.line,
+                                           body.line_start));
+    context.first_token = token::BODY_ONLY;
+
+    bool is_parsed;
+    if (source.by_descent) {
+        is_parsed = parseProgramByDescent(context);
+    } else {
+        yy::parser parser(context);
+        is_parsed = parser.parse() == 0 && !context.has_error;
+    }
+    if (!is_parsed) {
+        source.has_error = true;
+        return nullptr;
+    }
+    return static_cast<CompoundStatementNode *>(context.root);
+}
+
+// The parser of --syntax-only: the grammar above without its actions, which
+// syntax.awk turns into syntax.y. It reports the same syntax errors but
+// builds nothing.
+#include "syntax.h"
+
+static_assert(static_cast<int>(syntax::parser::token::BAD_CHARACTER) ==
+                  static_cast<int>(token::BAD_CHARACTER),
+              "syntax.y numbers the tokens as parser.y does");
+
+int yylex(syntax::parser::semantic_type *, YYLTYPE *yylloc,
+          CompilationContext &context) {
+    TokenValue value;
+    return nextToken(context, value, *yylloc);
+}
+
+void syntax::parser::error(const location_type &, const std::string &) {
+    reportSyntaxError(context);
+}
+
+bool checkSyntax(CompilationContext &context) {
+    syntax::parser parser(context);
+    return parser.parse() == 0 && !context.has_error;
+}
 
-    yyparse();
+bool lexProgram(CompilationContext &context) {
+    TokenValue value;
+    YYLTYPE location;
+    const auto start = std::chrono::steady_clock::now();
+    size_t num_of_tokens = 0;
+    while (nextToken(context, value, location) != token::YYEOF) {
+        ++num_of_tokens;
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    fprintf(context.diagnostics, "lexed %zu tokens in %.6f s (%.0f tokens/s)\n",
+            num_of_tokens, elapsed.count(),
+            elapsed.count() > 0 ? num_of_tokens / elapsed.count() : 0.0);
+    return !context.has_error;
+}
 
-    if (argc >= 3 && strcmp(argv[2], "--dump-ast") == 0) {
-        AstDumper ast_dumper;
-        root->accept(ast_dumper);
+// whether the semantic values of two tokens of the kind are the same
+static bool isSameValue(const TokenKind kind, const TokenValue &a,
+                        const TokenValue &b) {
+    switch (kind) {
+    case TokenKind::kIdentifier:
+        return a.identifier == b.identifier;
+    case TokenKind::kIntLiteral:
+        return a.integer == b.integer;
+    case TokenKind::kRealLiteral:
+        // bit for bit, as a conversion difference may be tiny
+        return memcmp(&a.real, &b.real, sizeof(a.real)) == 0;
+    case TokenKind::kStringLiteral:
+        return a.string == b.string;
+    case TokenKind::kTrue:
+    case TokenKind::kFalse:
+        return a.boolean == b.boolean;
+    default:
+        return true;
     }
+}
 
-    SemanticAnalyzer sema_analyzer;
-    sema_analyzer.setSymbolTableDump(dumpSymbolTable);
-    sema_analyzer.setSourceCode(source_code);
-    root->accept(sema_analyzer);
-    
+static void printTokenDifference(FILE *const output, const size_t index,
+                                 const char *const what,
+                                 const YYLTYPE &flex_location,
+                                 const FlexScanner flex_scanner,
+                                 const Token &fast_token,
+                                 const char *const source) {
+    fprintf(output,
+            "lexer diff: token #%zu differs in %s\n"
+            "  flex: line %u, column %u: %.*s\n"
+            "  fast: line %u, column %u: %.*s\n",
+            index, what, flex_location.first_line, flex_location.first_column,
+            getFlexScannerLength(flex_scanner),
+            getFlexScannerText(flex_scanner), fast_token.line, fast_token.col,
+            static_cast<int>(fast_token.length), source + fast_token.offset);
+}
 
-    delete root;
-    fclose(yyin);
-    yylex_destroy();
-    return 0;
+// Scans the source with both lexers and compares the token streams (kind,
+// semantic value, location and spelling) and what they list.
+bool diffLexers(SourceBuffer &source, FILE *const output) {
+    // the tables that compile() would make for the lexers
+    StringInterner atoms;
+    StringLiteralPool literals;
+    const StringInterner::Scope atoms_scope(atoms);
+    const StringLiteralPool::Scope literals_scope(literals);
+
+    // FastLexer goes first, since flex temporarily writes into the buffer
+    FastLexer fast_lexer(source.getData(), source.getSize());
+    std::vector<Token> fast_tokens;
+    Token token;
+    do {
+        fast_lexer.next(token);
+        fast_tokens.push_back(token);
+    } while (token.kind != TokenKind::kEndOfInput &&
+             token.kind != TokenKind::kBadCharacter);
+
+    char *flex_listing = nullptr;
+    size_t flex_listing_size = 0;
+    FILE *const flex_listing_stream =
+        open_memstream(&flex_listing, &flex_listing_size);
+    FlexScannerState flex_state;
+    const FlexScanner flex_scanner =
+        createFlexScanner(source, flex_state, flex_listing_stream);
+
+    TokenValue flex_value = {};
+    YYLTYPE flex_location;
+    bool is_identical = true;
+    size_t index = 0;
+    for (; index < fast_tokens.size() && is_identical; ++index) {
+        const Token &fast_token = fast_tokens[index];
+        const int parser_token =
+            scanToken(&flex_value, &flex_location, flex_scanner);
+
+        const char *difference = nullptr;
+        if (parser_token !=
+            kParserTokens[static_cast<size_t>(fast_token.kind)]) {
+            difference = "kind";
+        } else if (parser_token == token::YYEOF) {
+            break;
+        } else if (flex_location.first_line != fast_token.line ||
+                   flex_location.first_column != fast_token.col) {
+            difference = "location";
+        } else if (getFlexScannerText(flex_scanner) !=
+                       source.getData() + fast_token.offset ||
+                   getFlexScannerLength(flex_scanner) !=
+                       static_cast<int>(fast_token.length)) {
+            difference = "spelling";
+        } else if (!isSameValue(fast_token.kind, flex_value,
+                                fast_token.value)) {
+            difference = "semantic value";
+        }
+
+        if (difference != nullptr) {
+            printTokenDifference(output, index, difference, flex_location,
+                                 flex_scanner, fast_token, source.getData());
+            is_identical = false;
+        }
+    }
+    destroyFlexScanner(flex_scanner);
+    fclose(flex_listing_stream);
+
+    const std::string &fast_listing = fast_lexer.getListing();
+    if (is_identical &&
+        (fast_listing.size() != flex_listing_size ||
+         memcmp(fast_listing.data(), flex_listing, flex_listing_size) != 0)) {
+        fprintf(output, "lexer diff: the listings differ\n");
+        is_identical = false;
+    }
+    if (is_identical && flex_state.line_num != fast_lexer.getLine()) {
+        fprintf(output, "lexer diff: the line counts differ\n");
+        is_identical = false;
+    }
+    if (is_identical &&
+        flex_state.dump_symbol_table != fast_lexer.getDumpSymbolTable()) {
+        fprintf(output, "lexer diff: the //&D pseudocomment states differ\n");
+        is_identical = false;
+    }
+    free(flex_listing);
+
+    if (is_identical) {
+        fprintf(output, "lexer diff: %zu tokens identical\n",
+                fast_tokens.size());
+    }
+    return is_identical;
 }
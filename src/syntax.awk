@@ -0,0 +1,102 @@
+# Derives syntax.y, the grammar of parser.y without its actions and semantic
+# values, for --syntax-only. The declarations stay as they are, so both
+# parsers number the tokens alike and share the lexers; the parser class is
+# syntax::parser, and its yylex() and error() are defined in parser.y.
+#
+#   awk -f syntax.awk parser.y > syntax.y
+
+BEGIN {
+    section = 1
+    depth = 0
+    in_comment = 0
+    print "/* Generated from parser.y by syntax.awk, do not edit. */"
+}
+
+# a one-line comment waits for the line it is about, which may be replaced
+function flush_comment() {
+    if (comment != "") {
+        print comment
+        comment = ""
+    }
+}
+
+/^%%/ {
+    flush_comment()
+    if (++section == 3) {
+        print
+        exit
+    }
+    print
+    next
+}
+
+section == 1 {
+    if ($0 ~ /^[ \t]*\/\*.*\*\/[ \t]*$/) {
+        flush_comment()
+        comment = $0
+        next
+    }
+    if ($0 ~ /^%type/) {
+        flush_comment()
+        next
+    }
+    if ($0 ~ /^%define api\.value\.type/) {
+        comment = ""
+        print "    /* no semantic values; the parser class is syntax::parser */"
+        print "%define api.namespace {syntax}"
+        next
+    }
+    flush_comment()
+    sub(/^%token <[^>]*>/, "%token")
+    gsub(/yy::parser/, "syntax::parser")
+    print
+    next
+}
+
+# the rules, with every { action } dropped; a brace in a string, character
+# literal or comment is no brace of an action
+{
+    line = ""
+    quote = ""
+    for (i = 1; i <= length($0); ++i) {
+        c = substr($0, i, 1)
+        pair = substr($0, i, 2)
+        text = c
+        if (in_comment) {
+            if (pair == "*/") {
+                in_comment = 0
+                text = pair
+                ++i
+            }
+        } else if (quote != "") {
+            if (c == "\\") {
+                text = pair
+                ++i
+            } else if (c == quote) {
+                quote = ""
+            }
+        } else if (pair == "//") {
+            text = substr($0, i)
+            i = length($0)
+        } else if (pair == "/*") {
+            in_comment = 1
+            text = pair
+            ++i
+        } else if (c == "\"" || c == "'") {
+            quote = c
+        } else if (c == "{") {
+            ++depth
+            text = ""
+        } else if (c == "}") {
+            --depth
+            text = ""
+        }
+        if (depth == 0) {
+            line = line text
+        }
+    }
+    if (line !~ /^[ \t]*$/ || depth == 0 && $0 ~ /^[ \t]*$/) {
+        sub(/[ \t]+$/, "", line)
+        print line
+    }
+}
@@ -0,0 +1,416 @@
+#!/usr/bin/python3
+
+import os
+import random
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from argparse import ArgumentParser
+
+
+class Benchmark:
+
+    # listings off, so that only scanning is measured
+    header = "//&S-\n//&T-\n//&D-\n"
+    words = ["var", "array", "of", "boolean", "integer", "real", "string",
+             "true", "false", "def", "return", "begin", "end", "while", "do",
+             "if", "then", "else", "for", "to", "print", "read",
+             "mod", "and", "or", "not"]
+    symbols = [",", ";", ":", "(", ")", "[", "]", "+", "-", "*", "/", ":=",
+               "<", "<=", "<>", ">=", ">", "="]
+
+    # full-tree walks per measurement in --mode=visit
+    num_of_traversals = 20
+
+    def __init__(self, parsers, lexers, runs, mode):
+        self.parsers = parsers
+        self.lexers = lexers
+        self.runs = runs
+        self.mode = mode
+
+    def gen_source(self, path, size):
+        """Writes a token soup of about `size` bytes, half of it keywords."""
+        rng = random.Random(0)
+        with open(path, "w") as out:
+            out.write(self.header)
+            written = len(self.header)
+            while written < size:
+                tokens = []
+                for _ in range(12):
+                    r = rng.random()
+                    if r < 0.5:
+                        tokens.append(rng.choice(self.words))
+                    elif r < 0.7:
+                        tokens.append("id%d" % rng.randrange(1000))
+                    elif r < 0.8:
+                        tokens.append(str(rng.randrange(100000)))
+                    else:
+                        tokens.append(rng.choice(self.symbols))
+                line = " ".join(tokens) + "\n"
+                out.write(line)
+                written += len(line)
+
+    def gen_program(self, path, size):
+        """Writes a valid program of about `size` bytes: many functions with
+        declarations, loops, conditions and expressions."""
+        rng = random.Random(0)
+        with open(path, "w") as out:
+            out.write(self.header)
+            out.write("bench;\nvar g: integer;\n"
+                      "var arr: array 10 of array 10 of integer;\n")
+            written = out.tell()
+            num_of_functions = 0
+            while written < size:
+                lines = ["f%d(a, b: integer; r: real): integer" % num_of_functions,
+                         "begin",
+                         "  var x, y, z: integer;",
+                         "  var s: string;"]
+                for k in range(8):
+                    c = rng.randrange(4)
+                    if c == 0:
+                        lines.append("  x := a + %d * (b - y) mod 3;" % k)
+                    elif c == 1:
+                        lines.append("  if x > %d and not (y = z) then begin s := \"str\"; "
+                                     "print s; end else begin arr[x][y] := arr[y][x] + 1; "
+                                     "end end if" % k)
+                    elif c == 2:
+                        lines.append("  for i := 1 to %d do begin z := z + i; print -z; "
+                                     "end end do" % (k + 2))
+                    else:
+                        lines.append("  while y < 100 do begin y := y + x * 2; end end do")
+                lines += ["  return x + y;", "end", "end", ""]
+                text = "\n".join(lines)
+                out.write(text)
+                written += len(text)
+                num_of_functions += 1
+            out.write("begin\n  g := 1;\nend\nend\n")
+
+    def gen_expressions(self, path, size):
+        """Writes a valid program of about `size` bytes that is mostly long
+        arithmetic and boolean expressions. Returns the number of binary and
+        unary operators in it."""
+        rng = random.Random(0)
+        arithmetic = ["+", "-", "*", "/", "mod"]
+        relational = ["<", "<=", "=", ">=", ">", "<>"]
+        num_of_operators = 0
+
+        def operand(depth):
+            nonlocal num_of_operators
+            r = rng.random()
+            if depth < 3 and r < 0.2:
+                return "(" + arith(depth + 1) + ")"
+            if r < 0.3:
+                num_of_operators += 1
+                return "-" + rng.choice(["a", "b", "x"])
+            if r < 0.6:
+                return rng.choice(["a", "b", "x", "y", "arr[x][y]"])
+            return str(rng.randrange(1000))
+
+        def arith(depth):
+            nonlocal num_of_operators
+            terms = [operand(depth) for _ in range(rng.randrange(2, 8))]
+            num_of_operators += len(terms) - 1
+            return terms[0] + "".join(" %s %s" % (rng.choice(arithmetic), t)
+                                      for t in terms[1:])
+
+        def condition():
+            nonlocal num_of_operators
+            parts = []
+            for _ in range(rng.randrange(1, 5)):
+                part = "%s %s %s" % (arith(1), rng.choice(relational), arith(1))
+                num_of_operators += 1
+                if rng.random() < 0.3:
+                    part = "not (%s)" % part
+                    num_of_operators += 1
+                parts.append(part)
+            num_of_operators += len(parts) - 1
+            return "".join(p + rng.choice([" and ", " or "])
+                           for p in parts[:-1]) + parts[-1]
+
+        with open(path, "w") as out:
+            out.write(self.header)
+            out.write("bench;\nvar arr: array 10 of array 10 of integer;\n")
+            written = out.tell()
+            num_of_functions = 0
+            while written < size:
+                lines = ["f%d(a, b: integer): integer" % num_of_functions,
+                         "begin",
+                         "  var x, y: integer;"]
+                for _ in range(8):
+                    if rng.random() < 0.5:
+                        lines.append("  x := %s;" % arith(0))
+                    else:
+                        lines.append("  if %s then begin y := %s; end end if" %
+                                     (condition(), arith(0)))
+                lines += ["  return x;", "end", "end", ""]
+                text = "\n".join(lines)
+                out.write(text)
+                written += len(text)
+                num_of_functions += 1
+            out.write("begin\nend\nend\n")
+        return num_of_operators
+
+    def measure_parse_time(self, clist):
+        """Returns the best time in seconds that the parser reports over the
+        runs (--parse-only)."""
+        best = None
+        for _ in range(self.runs):
+            proc = subprocess.run(clist, stdout=subprocess.DEVNULL,
+                                  stderr=subprocess.PIPE)
+            stderr = str(proc.stderr, "utf-8")
+            match = re.search(r"parsed [0-9.]+ MiB in ([0-9.]+) s", stderr)
+            if proc.returncode != 0 or match is None:
+                print("Call of '%s' failed: %s" % (" ".join(clist), stderr))
+                sys.exit(1)
+            seconds = float(match.group(1))
+            best = seconds if best is None else min(best, seconds)
+        return best
+
+    def measure_time(self, clist, runs=None):
+        """Returns the best wall-clock time in seconds over the runs."""
+        best = None
+        for _ in range(runs or self.runs):
+            start = time.perf_counter()
+            proc = subprocess.run(clist, stdout=subprocess.DEVNULL,
+                                  stderr=subprocess.PIPE)
+            elapsed = time.perf_counter() - start
+            if proc.returncode != 0:
+                print("Call of '%s' failed: %s" % (" ".join(clist), str(proc.stderr, "utf-8")))
+                sys.exit(1)
+            best = elapsed if best is None else min(best, elapsed)
+        return best
+
+    def measure_peak_memory(self, clist):
+        """Returns the peak resident set size of a run in MiB."""
+        proc = subprocess.Popen(clist, stdout=subprocess.DEVNULL,
+                                stderr=subprocess.PIPE)
+        stderr = proc.stderr.read()
+        _, status, rusage = os.wait4(proc.pid, 0)
+        proc.returncode = os.waitstatus_to_exitcode(status)
+        if proc.returncode != 0:
+            print("Call of '%s' failed: %s" % (" ".join(clist), str(stderr, "utf-8")))
+            sys.exit(1)
+        return rusage.ru_maxrss / 1024
+
+    def measure(self, parser, lexer, source):
+        """Returns the best throughput in tokens/s over the runs."""
+        best = 0.0
+        for _ in range(self.runs):
+            clist = [parser, source, "--lex-only", "--lexer=%s" % lexer]
+            proc = subprocess.run(clist, stdout=subprocess.DEVNULL,
+                                  stderr=subprocess.PIPE)
+            stderr = str(proc.stderr, "utf-8")
+            match = re.search(r"lexed (\d+) tokens in ([0-9.]+) s", stderr)
+            if proc.returncode != 0 or match is None:
+                print("Call of '%s' failed: %s" % (" ".join(clist), stderr))
+                sys.exit(1)
+            seconds = float(match.group(2))
+            if seconds > 0:
+                best = max(best, int(match.group(1)) / seconds)
+        return best
+
+    def run_parse(self, source):
+        """--syntax-only against the whole front end (parsing, building the
+        AST and semantic analysis)."""
+        size = os.path.getsize(source) / (1 << 20)
+        print("---\tParser\t\tLexer\t\tSyntax-only MiB/s\tFull MiB/s\tSpeedup")
+        for parser in self.parsers:
+            for lexer in self.lexers:
+                clist = [parser, source, "--lexer=%s" % lexer]
+                syntax_only = self.measure_time(clist + ["--syntax-only"])
+                full = self.measure_time(clist)
+                print("---\t%s\t%s\t\t%.1f\t\t\t%.1f\t\t%.1fx" %
+                      (parser, lexer, size / syntax_only, size / full,
+                       full / syntax_only))
+
+    def run_stream(self, source):
+        """The whole front end against --stream, which analyzes and drops
+        one function at a time."""
+        size = os.path.getsize(source) / (1 << 20)
+        print("---\tParser\t\tLexer\t\tMiB/s\tPeak MiB\tStream MiB/s\tStream peak MiB")
+        for parser in self.parsers:
+            for lexer in self.lexers:
+                clist = [parser, source, "--lexer=%s" % lexer]
+                full = self.measure_time(clist)
+                full_peak = self.measure_peak_memory(clist)
+                stream = self.measure_time(clist + ["--stream"])
+                stream_peak = self.measure_peak_memory(clist + ["--stream"])
+                print("---\t%s\t%s\t\t%.1f\t%.1f\t\t%.1f\t\t%.1f" %
+                      (parser, lexer, size / full, full_peak, size / stream,
+                       stream_peak))
+
+    def run_cache(self, source):
+        """The whole front end without the AST cache, with a cache that
+        misses (filling it) and with one that hits (--ast-cache)."""
+        size = os.path.getsize(source) / (1 << 20)
+        print("---\tParser\t\tLexer\t\tMiB/s\tMiss MiB/s\tHit MiB/s\tSpeedup")
+        for parser in self.parsers:
+            for lexer in self.lexers:
+                clist = [parser, source, "--lexer=%s" % lexer]
+                uncached = self.measure_time(clist)
+                cache = tempfile.mkdtemp()
+                try:
+                    cache_option = "--ast-cache=%s" % cache
+                    miss = None
+                    for _ in range(self.runs):
+                        for entry in os.listdir(cache):
+                            os.remove(os.path.join(cache, entry))
+                        elapsed = self.measure_time(clist + [cache_option], 1)
+                        miss = elapsed if miss is None else min(miss, elapsed)
+                    hit = self.measure_time(clist + [cache_option])
+                finally:
+                    shutil.rmtree(cache)
+                print("---\t%s\t%s\t\t%.1f\t%.1f\t\t%.1f\t\t%.2fx" %
+                      (parser, lexer, size / uncached, size / miss,
+                       size / hit, uncached / hit))
+
+    def run_expressions(self, source, num_of_operators):
+        """bison's LALR parser against the recursive-descent one on
+        expression-heavy input, parsing only (--parse-only)."""
+        size = os.path.getsize(source) / (1 << 20)
+        print("---\tParser\t\tLexer\t\t%d operators in %.1f MiB" %
+              (num_of_operators, size))
+        print("---\t\t\t\t\tbison MiB/s\tMops/s\tdescent MiB/s\tMops/s\tSpeedup")
+        for parser in self.parsers:
+            for lexer in self.lexers:
+                clist = [parser, source, "--parse-only", "--lexer=%s" % lexer]
+                bison = self.measure_parse_time(clist + ["--parser=bison"])
+                descent = self.measure_parse_time(clist + ["--parser=descent"])
+                print("---\t%s\t%s\t\t%.1f\t\t%.1f\t%.1f\t\t%.1f\t%.2fx" %
+                      (parser, lexer, size / bison,
+                       num_of_operators / bison / 1e6, size / descent,
+                       num_of_operators / descent / 1e6, bison / descent))
+
+    def run_traversals(self, source):
+        """Full-tree walks a second, with the virtual AstNodeVisitor, the
+        statically dispatched AstStaticVisitor and the stack-based AstWalker
+        (--traversals)."""
+        print("---\tParser\t\tNodes\tAstNodeVisitor/s\tAstStaticVisitor/s\tSpeedup\tAstWalker/s\tSpeedup")
+        for parser in self.parsers:
+            best = None
+            for _ in range(self.runs):
+                clist = [parser, source, "--parse-only", "--lexer=fast",
+                         "--traversals=%d" % self.num_of_traversals]
+                proc = subprocess.run(clist, stdout=subprocess.DEVNULL,
+                                      stderr=subprocess.PIPE)
+                stderr = str(proc.stderr, "utf-8")
+                match = re.search(r"traversed (\d+) nodes \d+ times: ([0-9.]+)/s "
+                                  r"with AstNodeVisitor, ([0-9.]+)/s with AstStaticVisitor "
+                                  r"\([0-9.]+x\), ([0-9.]+)/s with AstWalker", stderr)
+                if proc.returncode != 0 or match is None:
+                    print("Call of '%s' failed: %s" % (" ".join(clist), stderr))
+                    sys.exit(1)
+                rates = (int(match.group(1)), float(match.group(2)),
+                         float(match.group(3)), float(match.group(4)))
+                if best is None:
+                    best = rates
+                else:
+                    best = (best[0],) + tuple(max(a, b) for a, b in zip(best[1:], rates[1:]))
+            print("---\t%s\t%d\t%.1f\t\t\t%.1f\t\t\t%.2fx\t%.1f\t\t%.2fx" %
+                  (parser, best[0], best[1], best[2], best[2] / best[1],
+                   best[3], best[3] / best[1]))
+
+    def count_nodes(self, parser, source):
+        """Returns the number of nodes in the AST of the source
+        (--traversals)."""
+        clist = [parser, source, "--parse-only", "--lexer=fast", "--traversals=1"]
+        proc = subprocess.run(clist, stdout=subprocess.DEVNULL,
+                              stderr=subprocess.PIPE)
+        stderr = str(proc.stderr, "utf-8")
+        match = re.search(r"traversed (\d+) nodes", stderr)
+        if proc.returncode != 0 or match is None:
+            print("Call of '%s' failed: %s" % (" ".join(clist), stderr))
+            sys.exit(1)
+        return int(match.group(1))
+
+    def run_dump(self, source):
+        """AST nodes dumped a second in each format (--dump-ast=FORMAT), the
+        time of a run with the dump less that of one without. A format that
+        the parser does not know is shown as '-'."""
+        formats = ["text", "json", "bin"]
+        print("---\tParser\t\tNodes\t" + "\t".join("%s nodes/s" % f for f in formats))
+        for parser in self.parsers:
+            num_of_nodes = self.count_nodes(parser, source)
+            clist = [parser, source, "--lexer=fast"]
+            without = self.measure_time(clist)
+            rates = []
+            for dump_format in formats:
+                option = "--dump-ast" if dump_format == "text" else "--dump-ast=%s" % dump_format
+                proc = subprocess.run([parser, os.devnull, option],
+                                      stdout=subprocess.DEVNULL,
+                                      stderr=subprocess.PIPE)
+                if b"Unknown option" in proc.stderr:
+                    rates.append("-")
+                    continue
+                dump = self.measure_time(clist + [option]) - without
+                rates.append("%.0f" % (num_of_nodes / dump) if dump > 0 else "inf")
+            print("---\t%s\t%d\t%s" % (parser, num_of_nodes, "\t\t".join(rates)))
+
+    def run(self, size) -> int:
+        fd, source = tempfile.mkstemp(suffix=".p")
+        os.close(fd)
+        try:
+            if self.mode == "parse":
+                self.gen_program(source, size)
+                self.run_parse(source)
+                return 0
+            if self.mode == "expr":
+                num_of_operators = self.gen_expressions(source, size)
+                self.run_expressions(source, num_of_operators)
+                return 0
+            if self.mode == "visit":
+                self.gen_program(source, size)
+                self.run_traversals(source)
+                return 0
+            if self.mode == "cache":
+                self.gen_program(source, size)
+                self.run_cache(source)
+                return 0
+            if self.mode == "dump":
+                self.gen_program(source, size)
+                self.run_dump(source)
+                return 0
+            if self.mode == "stream":
+                self.gen_program(source, size)
+                self.run_stream(source)
+                return 0
+
+            self.gen_source(source, size)
+            print("---\tParser\t\tLexer\t\tTokens/s")
+            for parser in self.parsers:
+                for lexer in self.lexers:
+                    rate = self.measure(parser, lexer, source)
+                    print("---\t%s\t%s\t\t%.0f" % (parser, lexer, rate))
+        finally:
+            os.remove(source)
+        return 0
+
+
+def main() -> int:
+    parser = ArgumentParser()
+    parser.add_argument("--parser", help="parser to benchmark (repeatable), e.g. the current and a previous build",
+                        action="append", default=[])
+    parser.add_argument("--lexer", help="lexer to benchmark (repeatable)",
+                        action="append", default=[])
+    parser.add_argument("--size", help="size of the generated source in MiB", type=int, default=16)
+    parser.add_argument("--runs", help="runs per measurement, the best one counts", type=int, default=3)
+    parser.add_argument("--mode", help="lex: lexer throughput (--lex-only); parse: --syntax-only against the full front end; "
+                        "stream: time and peak memory of the full front end with and without --stream; "
+                        "expr: bison's parser against --parser=descent on expression-heavy input; "
+                        "visit: full-tree walks a second, virtual against static dispatch and AstWalker (--traversals); "
+                        "cache: the full front end without the AST cache, missing and hitting it (--ast-cache); "
+                        "dump: AST nodes dumped a second as text, JSON and an AST file (--dump-ast=FORMAT)",
+                        choices=["lex", "parse", "stream", "expr", "visit", "cache", "dump"], default="lex")
+    args = parser.parse_args()
+
+    b = Benchmark(parsers = args.parser or ["../src/parser"],
+                  lexers = args.lexer or ["flex", "fast"],
+                  runs = args.runs,
+                  mode = args.mode)
+    return b.run(args.size << 20)
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,38 @@
+#!/usr/bin/python3
+
+"""Reads the output of `parser --dump-ast=json` and prints a line for each
+expression of the AST, in the order of the dump: where it is, its kind and
+name, operator or value, the type that semantic analysis gave it ("-" for
+none) and, for references and calls, where what it refers to is declared
+("-" for nothing)."""
+
+import json
+import sys
+
+
+def print_expressions(node):
+    if "result_type" in node:
+        label = node.get("name", node.get("operator", node.get("value")))
+        result_type = node["result_type"]
+        line = "%d:%d %s %s: %s" % (node["line"], node["col"], node["kind"],
+                                   label, "-" if result_type is None else result_type)
+        if "declaration" in node:
+            declaration = node["declaration"]
+            line += " @ " + ("-" if declaration is None else
+                             "%d:%d" % (declaration["line"], declaration["col"]))
+        print(line)
+    for child in node.get("children", []):
+        print_expressions(child)
+
+
+def main() -> int:
+    for line in sys.stdin:
+        if line.startswith('{"kind":"program"'):
+            print_expressions(json.loads(line))
+            return 0
+    print("no JSON dump of the AST in the input", file=sys.stderr)
+    return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
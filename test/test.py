@@ -33,8 +33,9 @@ class Grader:
 
     diff_result = ""
 
-    def __init__(self, parser):
+    def __init__(self, parser, parser_options):
         self.parser = parser
+        self.parser_options = parser_options
 
         self.output_dir = "result"
         if not os.path.exists(self.output_dir):
@@ -53,7 +54,7 @@ class Grader:
         test_case = "%s/%s/%s.p" % (self.basic_case_dir, "test_cases", self.basic_cases[case_id])
         output_file = "%s/%s" % (self.output_dir, self.basic_cases[case_id])
 
-        clist = [self.parser, test_case]
+        clist = [self.parser, test_case] + self.parser_options
         try:
             proc = subprocess.Popen(clist, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
         except Exception as e:
@@ -157,9 +158,11 @@ def main() -> int:
     parser = ArgumentParser()
     parser.add_argument("--parser", help="parser to grade", default="../src/parser")
     parser.add_argument("--basic_case_id", help="test case's ID", type=int, default=0)
+    parser.add_argument("--parser_option", help="option passed to the parser (repeatable), e.g. --parser_option=--lexer=fast",
+                        action="append", default=[])
     args = parser.parse_args()
 
-    g = Grader(parser = args.parser)
+    g = Grader(parser = args.parser, parser_options = args.parser_option)
     g.get_case_id_list(args.basic_case_id)
     return g.run()
 